@@ -0,0 +1,184 @@
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <meta>
+#include <new>
+#include <print>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <imgui.h>
+
+#include "imrefl.hpp"
+
+// Every allocation made through the global operator new or through ImGui's
+// allocator bumps this counter, so each workload can report allocations per
+// frame alongside its timings.
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+consteval std::string member_name(std::size_t index)
+{
+    std::string name = "m";
+    std::string digits;
+    do {
+        digits.insert(digits.begin(), static_cast<char>('0' + index % 10));
+        index /= 10;
+    } while (index != 0);
+    return name + digits;
+}
+
+// A single aggregate with many scalar members, generated with reflection.
+struct wide;
+consteval {
+    std::vector<std::meta::info> members;
+    for (std::size_t i = 0; i != 256; ++i) {
+        const auto type = (i % 2 == 0) ? ^^int : ^^float;
+        members.push_back(std::meta::data_member_spec(type, {.name = member_name(i)}));
+    }
+    std::meta::define_aggregate(^^wide, members);
+}
+
+template <int Depth>
+struct nested
+{
+    int               value;
+    float             weight;
+    nested<Depth - 1> child;
+};
+
+template <>
+struct nested<0>
+{
+    int   value;
+    float weight;
+};
+
+struct particle
+{
+    int   id;
+    float position[3];
+    float velocity[3];
+    bool  alive;
+};
+
+enum class opcode
+{
+    nop, load, store, add, sub, mul, div, jump, branch, call, ret, halt
+};
+
+class headless_context
+{
+public:
+    headless_context()
+    {
+        IMGUI_CHECKVERSION();
+        ImGui::SetAllocatorFunctions(
+            [](std::size_t size, void*) { ++allocations; return std::malloc(size); },
+            [](void* ptr, void*) { std::free(ptr); }
+        );
+        ImGui::CreateContext();
+
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.DisplaySize = {1920.0f, 1080.0f};
+        io.DeltaTime = 1.0f / 60.0f;
+
+        // There is no renderer, so build the font atlas in memory and never upload it
+#if IMGUI_VERSION_NUM >= 19200
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+#else
+        unsigned char* pixels = nullptr;
+        int width = 0;
+        int height = 0;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+#endif
+    }
+
+    ~headless_context()
+    {
+        ImGui::DestroyContext();
+    }
+
+    headless_context(const headless_context&) = delete;
+    headless_context& operator=(const headless_context&) = delete;
+};
+
+template <typename T>
+void render_frame(T&& value)
+{
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos({0.0f, 0.0f});
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin("bench");
+    ImRefl::Input("value", std::forward<T>(value));
+    ImGui::End();
+    ImGui::Render();
+}
+
+template <typename T>
+void run(const char* label, T&& value, int frames)
+{
+    // Let ImGui settle its window, tree node and table state before measuring
+    for (int i = 0; i != 10; ++i) {
+        render_frame(value);
+    }
+
+    allocations = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i != frames; ++i) {
+        render_frame(value);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    std::println("{:<28} {:>14.0f} {:>14.2f}", label, ns / frames, static_cast<double>(allocations) / frames);
+}
+
+template <typename T>
+void run_both(const char* label, T& value, int frames)
+{
+    run(label, value, frames);
+    run((std::string(label) + " (const)").c_str(), std::as_const(value), frames);
+}
+
+int main(int argc, char** argv)
+{
+    const int frames = (argc > 1) ? std::atoi(argv[1]) : 200;
+    headless_context context;
+
+    auto wide_value = wide{};
+    auto nested_value = nested<32>{};
+    auto particles = std::vector<particle>(10000);
+    auto table = std::map<int, float>{};
+    for (int i = 0; i != 10000; ++i) {
+        table.emplace(i, static_cast<float>(i));
+    }
+    auto strings = std::vector<std::string>(1000, "The quick brown fox jumps over the lazy dog");
+    auto variants = std::vector<std::variant<int, float, std::string>>(1000);
+    auto opcodes = std::array<opcode, 1000>{};
+
+    std::println("{:<28} {:>14} {:>14}", "workload", "ns/frame", "allocs/frame");
+    run_both("wide aggregate", wide_value, frames);
+    run_both("deep nesting", nested_value, frames);
+    run_both("vector<particle>", particles, frames);
+    run_both("map<int, float>", table, frames);
+    run_both("vector<string>", strings, frames);
+    run_both("vector<variant>", variants, frames);
+    run_both("array<enum>", opcodes, frames);
+    return 0;
+}
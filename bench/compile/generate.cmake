@@ -0,0 +1,56 @@
+# Writes a translation unit that renders a generated aggregate through both the
+# mutable and const overloads of ImRefl::Input.
+#
+#   members - number of data members on each struct
+#   depth   - number of nested structs, each holding the next as its last member
+#   mix     - "scalar" for arithmetic members, "container" for standard library types
+function(imrefl_generate_scenario path members depth mix)
+  if (mix STREQUAL "scalar")
+    set(types "int" "float" "bool" "double")
+  elseif (mix STREQUAL "container")
+    set(types
+      "std::vector<int>"
+      "std::map<int, float>"
+      "std::string"
+      "std::optional<float>"
+      "std::array<float, 3>"
+    )
+  else()
+    message(FATAL_ERROR "Unknown compile benchmark mix '${mix}'")
+  endif()
+  list(LENGTH types num_types)
+
+  set(source "// Generated by bench/compile/generate.cmake; do not edit.\n")
+  string(APPEND source "#include <array>\n#include <map>\n#include <optional>\n#include <string>\n#include <utility>\n#include <vector>\n\n")
+  string(APPEND source "#include \"imrefl.hpp\"\n\n")
+
+  # Innermost struct first so that each struct can hold the next one
+  math(EXPR last_level "${depth} - 1")
+  foreach (level RANGE ${last_level} 0 -1)
+    string(APPEND source "struct level${level}\n{\n")
+    math(EXPR last_member "${members} - 1")
+    foreach (i RANGE 0 ${last_member})
+      math(EXPR type_index "${i} % ${num_types}")
+      list(GET types ${type_index} type)
+      string(APPEND source "    ${type} m${i};\n")
+    endforeach()
+    if (level LESS last_level)
+      math(EXPR child "${level} + 1")
+      string(APPEND source "    level${child} child;\n")
+    endif()
+    string(APPEND source "};\n\n")
+  endforeach()
+
+  string(APPEND source "bool render(level0& value)\n{\n")
+  string(APPEND source "    ImRefl::Input(\"const\", std::as_const(value));\n")
+  string(APPEND source "    return ImRefl::Input(\"value\", value);\n}\n")
+
+  # Only touch the file when the contents change to avoid needless rebuilds
+  if (EXISTS "${path}")
+    file(READ "${path}" existing)
+    if (existing STREQUAL source)
+      return()
+    endif()
+  endif()
+  file(WRITE "${path}" "${source}")
+endfunction()
@@ -0,0 +1,90 @@
+# Summarises the results of the compile benchmark. Invoked by the
+# imrefl-compile-bench target with:
+#
+#   SCENARIOS      - "|"-separated list of scenario names
+#   OBJECT_<name>  - path to the object file of each scenario
+#   OUTPUT         - path of the CSV file to write
+#
+# Front-end time and instantiation counts come from the Clang -ftime-trace
+# output written next to each object file.
+
+# Returns the value of a field of the "Total <event>" entry of a time trace
+function(trace_total trace event field out)
+  set(value "n/a")
+  if (field STREQUAL "dur")
+    string(REGEX MATCH "\"dur\":([0-9]+),\"name\":\"Total ${event}\"" match "${trace}")
+  else()
+    string(REGEX MATCH "\"name\":\"Total ${event}\",\"args\":{\"count\":([0-9]+)" match "${trace}")
+  endif()
+  if (match)
+    set(value "${CMAKE_MATCH_1}")
+  endif()
+  set(${out} "${value}" PARENT_SCOPE)
+endfunction()
+
+function(format_ms microseconds out)
+  if (microseconds STREQUAL "n/a")
+    set(${out} "n/a" PARENT_SCOPE)
+  else()
+    math(EXPR ms "${microseconds} / 1000")
+    set(${out} "${ms}" PARENT_SCOPE)
+  endif()
+endfunction()
+
+function(pad text width out)
+  string(LENGTH "${text}" length)
+  set(padded "${text}")
+  while (length LESS width)
+    string(APPEND padded " ")
+    math(EXPR length "${length} + 1")
+  endwhile()
+  set(${out} "${padded}" PARENT_SCOPE)
+endfunction()
+
+string(REPLACE "|" ";" scenarios "${SCENARIOS}")
+
+set(csv "scenario,frontend_ms,total_ms,function_instantiations,class_instantiations,object_bytes\n")
+set(columns "scenario" "frontend ms" "total ms" "fn insts" "class insts" "object bytes")
+set(widths 24 14 14 14 14 14)
+
+set(header "")
+foreach (index RANGE 5)
+  list(GET columns ${index} column)
+  list(GET widths ${index} width)
+  pad("${column}" ${width} column)
+  string(APPEND header "${column}")
+endforeach()
+message("${header}")
+
+foreach (scenario IN LISTS scenarios)
+  set(object "${OBJECT_${scenario}}")
+  file(SIZE "${object}" object_bytes)
+
+  string(REGEX REPLACE "\\.(o|obj)$" ".json" trace_path "${object}")
+  set(trace "")
+  if (EXISTS "${trace_path}")
+    file(READ "${trace_path}" trace)
+  endif()
+
+  trace_total("${trace}" "Frontend" dur frontend_us)
+  trace_total("${trace}" "ExecuteCompiler" dur total_us)
+  trace_total("${trace}" "InstantiateFunction" count function_insts)
+  trace_total("${trace}" "InstantiateClass" count class_insts)
+  format_ms("${frontend_us}" frontend_ms)
+  format_ms("${total_us}" total_ms)
+
+  set(values "${scenario}" "${frontend_ms}" "${total_ms}" "${function_insts}" "${class_insts}" "${object_bytes}")
+  set(row "")
+  foreach (index RANGE 5)
+    list(GET values ${index} value)
+    list(GET widths ${index} width)
+    pad("${value}" ${width} value)
+    string(APPEND row "${value}")
+  endforeach()
+  message("${row}")
+
+  string(APPEND csv "${scenario},${frontend_ms},${total_ms},${function_insts},${class_insts},${object_bytes}\n")
+endforeach()
+
+file(WRITE "${OUTPUT}" "${csv}")
+message("Results written to ${OUTPUT}")
@@ -57,6 +57,31 @@ struct example
         octagon
     };
 
+    struct particle
+    {
+        int id;
+        float x;
+        float y;
+        [[=ImRefl::readonly]] float lifetime;
+    };
+
+    struct tracked
+    {
+        static void count_edit(tracked& self, int&) { ++self.edits; }
+
+        [[=ImRefl::on_change(&tracked::count_edit)]] int value;
+        [[=ImRefl::readonly]] int edits;
+    };
+
+    struct [[=ImRefl::table_driven]] settings
+    {
+        [[=ImRefl::slider(1, 240)]] int fps_limit = 60;
+        bool vsync = true;
+        [[=ImRefl::separator("Audio")]]
+        [[=ImRefl::drag(0, 1, 0.01f)]] float volume = 0.5f;
+        [[=ImRefl::readonly]] int channels = 2;
+    };
+
     [[=ImRefl::begin_region("Enumeration types")]]
     color enum_;
     const color const_enum_;
@@ -214,6 +239,17 @@ struct example
     [[=ImRefl::radio]] shape radio_attn_;
     [[=ImRefl::in_line]] float in_line_attn_[3];
     [[=ImRefl::non_resizable]] std::vector<int> non_resizable_attn_ = {0, 0, 0, 0};
+    [[=ImRefl::clipped]] std::vector<int> clipped_attn_ = std::vector<int>(100000);
+    [[=ImRefl::paged(50)]] std::list<int> paged_attn_ = std::list<int>(100000);
+    [[=ImRefl::plot()]] std::vector<float> plot_attn_ = std::vector<float>(1 << 20);
+    [[=ImRefl::histogram()]] float histogram_attn_[64];
+    [[=ImRefl::multiline(8)]] std::string multiline_attn_ = "Line one\nLine two\nLine three";
+    [[=ImRefl::hex]] std::vector<std::uint8_t> hex_attn_ = std::vector<std::uint8_t>(1 << 16);
+    [[=ImRefl::table]] std::vector<particle> table_attn_ = std::vector<particle>(100000);
+    settings table_driven_attn_;
+    tracked on_change_attn_;
+    [[=ImRefl::highlight_changes(0.5f)]] int highlight_changes_attn_;
+    [[=ImRefl::sample_every(500)]] std::function<double()> sample_every_attn_ = [] { return glfwGetTime(); };
 };
 
 int main()
@@ -255,18 +291,28 @@ int main()
     };
     ex.function_ = func;
 
+    ImRefl::History history;
+
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
 
         ex.time_point_ = system_clock::now();
         ex.duration_ = ex.time_point_ - ex.const_time_point_;
+        ex.highlight_changes_attn_ = static_cast<int>(glfwGetTime());
 
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
 
         ImGui::Begin("Debug");
-        ImRefl::Input("Example", ex);
+        ImGui::BeginDisabled(!history.CanUndo());
+        if (ImGui::Button("Undo")) { history.Undo(); }
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+        ImGui::BeginDisabled(!history.CanRedo());
+        if (ImGui::Button("Redo")) { history.Redo(); }
+        ImGui::EndDisabled();
+        ImRefl::Input("Example", ex, history);
         ImGui::End();
         ImGui::Render();
 
@@ -0,0 +1,10 @@
+// Primary interface of the imrefl module, which provides everything in
+// imrefl.hpp (and imrefl_glm.hpp when built with IMREFL_MODULE_GLM) through
+// import imrefl;
+export module imrefl;
+
+export import :core;
+
+#ifdef IMREFL_MODULE_GLM
+export import :glm;
+#endif
@@ -4,9 +4,18 @@
 #include <imgui.h>
 #include <imgui_internal.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <bitset>
+#include <cfloat>
+#include <climits>
+#include <charconv>
 #include <chrono>
 #include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <concepts>
 #include <expected>
 #include <format>
@@ -19,7 +28,6 @@
 #include <ranges>
 #include <set>
 #include <source_location>
-#include <stack>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -29,7 +37,12 @@
 #include <variant>
 #include <vector>
 
-namespace ImRefl {
+// Defined as export when this header is compiled as part of the imrefl module.
+#ifndef IMREFL_EXPORT
+#define IMREFL_EXPORT
+#endif
+
+IMREFL_EXPORT namespace ImRefl {
 
 // ============================================================================
 // LIBRARY CORE API
@@ -59,6 +72,20 @@ struct Config
     {
         return FetchAttn<T>().has_value();
     }
+
+    // For annotations whose type is a specialization of a class template, such
+    // as OnChange. Returns a reflection of the value, to be spliced.
+    consteval auto FetchAttnOfTemplate(std::meta::info tmpl) const -> std::optional<std::meta::info>
+    {
+        const auto attn_view = std::span<const std::meta::info>{attns, num_attns};
+        for (const auto attn : attn_view) {
+            const auto type = remove_cvref(type_of(attn));
+            if (has_template_arguments(type) && template_of(type) == tmpl) {
+                return attn;
+            }
+        }
+        return {};
+    }
 };
 
 // Specialize this struct for different types to enable them for
@@ -76,12 +103,470 @@ template <typename T>
 struct ExternalAnnotations
 {};
 
+namespace detail {
+
+template <Config config, typename T>
+bool render(const char* name, T&& value);
+
+} // namespace detail
+
+// Returns the position of a data member among the non-static data members of
+// its class, which is how it is identified within a ChangeSet path.
+consteval std::size_t MemberIndex(std::meta::info member)
+{
+    const auto ctx = std::meta::access_context::current();
+    const auto members = nonstatic_data_members_of(parent_of(member), ctx);
+    return static_cast<std::size_t>(std::ranges::find(members, member) - members.begin());
+}
+
+// The paths of the values modified by calls to Input. A path is the chain of
+// indices from the value passed to Input down to a modified value: the
+// MemberIndex of data members, and the position of elements within ranges and
+// tuples. Wrappers such as std::optional, std::variant and pointers do not add
+// to the path. Resizing a container records the path of the container itself.
+class ChangeSet
+{
+public:
+    using Path = std::span<const std::uint32_t>;
+
+    bool Empty() const { return starts.empty(); }
+    std::size_t Size() const { return starts.size(); }
+
+    Path operator[](std::size_t i) const
+    {
+        const std::size_t end = (i + 1 == starts.size()) ? indices.size() : starts[i + 1];
+        return Path{indices}.subspan(starts[i], end - starts[i]);
+    }
+
+    // Returns true if the value at the given path may have changed, which is
+    // the case if it, something within it or something containing it was
+    // modified.
+    bool Affects(Path path) const
+    {
+        for (std::size_t i = 0; i != Size(); ++i) {
+            const Path changed = (*this)[i];
+            const std::size_t common = std::min(changed.size(), path.size());
+            if (std::ranges::equal(changed.first(common), path.first(common))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Add(Path path)
+    {
+        starts.push_back(indices.size());
+        indices.insert(indices.end(), path.begin(), path.end());
+    }
+
+    void Clear()
+    {
+        indices.clear();
+        starts.clear();
+    }
+
+private:
+    std::vector<std::uint32_t> indices;
+    std::vector<std::size_t>   starts;
+};
+
+class History;
+
+namespace detail {
+
+// The address and type of the value found at the end of a path.
+struct located
+{
+    void*       ptr = nullptr;
+    const void* tag = nullptr;
+};
+
+template <typename T>
+inline constexpr char type_tag = 0;
+
+// Finds the value of the type identified by the tag at the given path.
+using locate_fn = located (*)(void* root, std::span<const std::uint32_t> path, const void* tag);
+
+template <typename T>
+located locate_root(void* root, std::span<const std::uint32_t> path, const void* tag);
+
+template <typename T>
+void copy_value(T& dst, const T& src);
+
+consteval bool has_shared_indirection(std::meta::info type);
+
+struct patch;
+
+// The type-specific part of a History entry. Applying it finds the edited
+// value through the entry and returns false if it no longer exists.
+struct patch_data
+{
+    virtual ~patch_data() = default;
+    virtual bool apply(const patch& entry, bool undo) = 0;
+    virtual void merge(patch_data& newer) {}
+};
+
+struct patch
+{
+    void*                       root      = nullptr;
+    locate_fn                   locate    = nullptr;
+    std::vector<std::uint32_t>  path;
+    ImGuiID                     active_id  = 0;
+    std::uint64_t               activation = 0; // Distinguishes separate activations of a widget
+    std::unique_ptr<patch_data> data;
+
+    // Returns the value of type T at the path of the entry followed by the
+    // given indices, or nullptr if there is no such value.
+    template <typename T>
+    T* find(std::initializer_list<std::uint32_t> suffix = {}) const
+    {
+        located target;
+        if (suffix.size() == 0) {
+            target = locate(root, path, &type_tag<T>);
+        } else {
+            auto full = path;
+            full.insert(full.end(), suffix);
+            target = locate(root, full, &type_tag<T>);
+        }
+        return target.tag == &type_tag<T> ? static_cast<T*>(target.ptr) : nullptr;
+    }
+};
+
+struct history_recorder;
+
+// Where changes made within the current call to Input are recorded, and the
+// path to the value being rendered. The path is relative to base, which is
+// where it stood when the ChangeSet, History or Watched was given to Input.
+// Edits go to either the History or the edits of a Watched value.
+struct change_recorder
+{
+    ChangeSet*                 target  = nullptr;
+    History*                   history = nullptr;
+    std::vector<patch>*        edits   = nullptr;
+    void*                      root    = nullptr;
+    locate_fn                  locate  = nullptr;
+    bool                       in_leaf = false;
+    std::vector<std::uint32_t> path;
+    std::size_t                base    = 0;
+};
+
+inline change_recorder& recorder()
+{
+    static change_recorder state;
+    return state;
+}
+
+// Bumped whenever elements are added to or removed from a container, which
+// invalidates iterators cached into containers.
+inline std::uint64_t& structure_generation()
+{
+    static std::uint64_t generation = 0;
+    return generation;
+}
+
+} // namespace detail
+
+// Drops the iterators cached into containers rendered with ImRefl::paged. Edits
+// made through Input do this automatically, but code that inserts into or
+// erases from such a container in any other way while it is shown must call
+// this before the next frame.
+inline void InvalidateCaches()
+{
+    ++detail::structure_generation();
+}
+
+// A bounded undo/redo history of the edits made through Input. Each entry holds
+// the path of the edited value along with its state before and after the edit,
+// so memory use is proportional to what was edited rather than to the size of
+// the object. Successive edits to a value while its widget stays active, such
+// as dragging a slider or typing into a text box, are merged into one entry.
+// Once full, the oldest entries are dropped. Entries point to the object passed
+// to Input, so the history must be cleared before that object is destroyed or
+// moved.
+class History
+{
+public:
+    explicit History(std::size_t capacity = 256)
+        : entries(std::max<std::size_t>(capacity, 1))
+    {}
+
+    bool CanUndo() const { return cursor != 0; }
+    bool CanRedo() const { return cursor != size; }
+    std::size_t Size() const { return size; }
+
+    // Returns false if there is nothing to undo, or if the edited value no
+    // longer exists, in which case the entry is skipped.
+    bool Undo()
+    {
+        if (!CanUndo()) {
+            return false;
+        }
+        --cursor;
+        return apply(entry(cursor), true);
+    }
+
+    bool Redo()
+    {
+        if (!CanRedo()) {
+            return false;
+        }
+        ++cursor;
+        return apply(entry(cursor - 1), false);
+    }
+
+    void Clear()
+    {
+        for (auto& e : entries) {
+            e = {};
+        }
+        first = 0;
+        size = 0;
+        cursor = 0;
+    }
+
+private:
+    friend struct detail::history_recorder;
+
+    std::vector<detail::patch> entries;
+    std::size_t                first  = 0;
+    std::size_t                size   = 0;
+    std::size_t                cursor = 0;
+
+    detail::patch& entry(std::size_t index)
+    {
+        return entries[(first + index) % entries.size()];
+    }
+
+    static bool apply(const detail::patch& entry, bool undo)
+    {
+        // Stop an active widget, such as a text box, from writing its own
+        // copy of the value back over the restored one
+        if (ImGui::GetCurrentContext()) {
+            ImGui::ClearActiveID();
+        }
+        return entry.data->apply(entry, undo);
+    }
+
+    void push(detail::patch&& next)
+    {
+        if (next.active_id != 0 && cursor == size && size != 0) {
+            auto& last = entry(size - 1);
+            if (last.active_id == next.active_id && last.activation == next.activation &&
+                last.root == next.root && last.path == next.path) {
+                last.data->merge(*next.data);
+                return;
+            }
+        }
+
+        for (std::size_t i = cursor; i != size; ++i) {
+            entry(i) = {};
+        }
+        size = cursor;
+        if (size == entries.size()) {
+            entry(0) = {};
+            first = (first + 1) % entries.size();
+            --size;
+        }
+        entry(size) = std::move(next);
+        cursor = ++size;
+    }
+};
+
+class EditQueue;
+
+template <typename T>
+class Watched;
+
+template <typename T>
+bool Input(const char* name, T& value, EditQueue& queue);
+
+template <typename T>
+bool Input(const char* name, Watched<T>& watched);
+
+// A bounded lock-free queue of the edits made through Input, from the thread
+// rendering a value to the thread that owns it. Each edit is a typed command
+// holding the path of the edited value, in the same form as a ChangeSet, and
+// what to do there: set a value, add or remove a container element, or change
+// the alternative of a variant. There must be one producing and one consuming
+// thread. When the queue is full, the producer keeps further edits and sends
+// them with its next edits, so nothing is dropped; the edits kept this way are
+// not bounded, so they use more memory for as long as the consumer stalls.
+class EditQueue
+{
+public:
+    explicit EditQueue(std::size_t capacity = 1024)
+        : slots(std::max<std::size_t>(capacity, 1))
+    {}
+
+    EditQueue(const EditQueue&) = delete;
+    EditQueue& operator=(const EditQueue&) = delete;
+
+    // Called by the consumer. Applies the queued edits to the value, which
+    // must be of the type given to Input, finding the edited values through
+    // their paths. Edits to values that no longer exist, or made to a value of
+    // another type, are dropped. Returns the number of edits taken.
+    template <typename T>
+    std::size_t Apply(T& value)
+    {
+        const std::size_t end = tail.load(std::memory_order_acquire);
+        std::size_t taken = head.load(std::memory_order_relaxed);
+        const std::size_t begin = taken;
+        for (; taken != end; ++taken) {
+            auto edit = std::move(slots[taken % slots.size()]);
+            if (edit.locate == &detail::locate_root<T>) {
+                edit.root = std::addressof(value);
+                edit.data->apply(edit, false);
+            }
+            head.store(taken + 1, std::memory_order_release);
+        }
+        return taken - begin;
+    }
+
+private:
+    template <typename T>
+    friend bool Input(const char* name, T& value, EditQueue& queue);
+
+    template <typename T>
+    friend class Watched;
+
+    // Called by the producer. Sends the edits held back while the queue was
+    // full, then the given ones, holding back whatever does not fit.
+    void push(std::vector<detail::patch>& edits)
+    {
+        if (edits.empty() && overflow_start == overflow.size()) {
+            return;
+        }
+        for (auto& edit : edits) {
+            overflow.push_back(std::move(edit));
+        }
+        edits.clear();
+
+        const std::size_t first = tail.load(std::memory_order_relaxed);
+        const std::size_t held = overflow.size() - overflow_start;
+        const std::size_t last = std::min(first + held, head.load(std::memory_order_acquire) + slots.size());
+        for (std::size_t i = first; i != last; ++i) {
+            slots[i % slots.size()] = std::move(overflow[overflow_start++]);
+        }
+        tail.store(last, std::memory_order_release);
+
+        // Drop the sent edits once they make up at least half of the overflow,
+        // so each held edit is moved a constant number of times on average
+        if (overflow_start == overflow.size()) {
+            overflow.clear();
+            overflow_start = 0;
+        } else if (overflow_start * 2 >= overflow.size()) {
+            overflow.erase(overflow.begin(), overflow.begin() + static_cast<std::ptrdiff_t>(overflow_start));
+            overflow_start = 0;
+        }
+    }
+
+    static constexpr std::size_t cache_line = 64;
+
+    std::vector<detail::patch>            slots;
+    alignas(cache_line) std::atomic<std::size_t> head = 0; // Next edit to apply
+    alignas(cache_line) std::atomic<std::size_t> tail = 0; // Next free slot
+    alignas(cache_line) std::vector<detail::patch> overflow; // Owned by the producer
+    std::size_t                           overflow_start = 0; // First edit in overflow not yet sent
+};
+
+// A value owned by another thread, such as a simulation, that can be inspected
+// and edited from the UI thread without locking the owner. The owner publishes
+// snapshots of its value with Publish and applies the edits made to them with
+// ApplyEdits, neither of which ever waits for the UI. Passing the Watched to
+// Input renders the latest snapshot and sends the edits made to it back as
+// patches, in the same form as History entries.
+//
+// Snapshots are triple buffered, so publishing only copies into a buffer the
+// UI is not using, and edits are sent through an EditQueue. Snapshots
+// published before the owner applied the edits sent to it are skipped, so an
+// edited value never jumps back while a widget is active.
+//
+// Snapshots would share anything reached through pointers, references, smart
+// pointers and views with the owner, so values containing them are rejected.
+template <typename T>
+class Watched
+{
+    static_assert(std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>,
+                  "a Watched value must be copyable");
+    static_assert(!detail::has_shared_indirection(^^T),
+                  "a Watched value cannot contain pointers, references, smart pointers or views, "
+                  "as its snapshots would share what they refer to with the owner");
+
+public:
+    Watched() requires std::default_initializable<T> = default;
+
+    explicit Watched(const T& value, std::size_t queue_capacity = 1024)
+        : buffers{value, value, value}
+        , edits(queue_capacity)
+    {}
+
+    Watched(const Watched&) = delete;
+    Watched& operator=(const Watched&) = delete;
+
+    // Called by the owner at a sync point. Copies the value into a free buffer,
+    // using memcpy for its trivially copyable parts, and makes it the latest.
+    void Publish(const T& value)
+    {
+        detail::copy_value(buffers[back], value);
+        const std::uint64_t previous = latest.exchange(pack(back, true, applied), std::memory_order_acq_rel);
+        back = index_of(previous);
+    }
+
+    // Called by the owner at a sync point, before Publish so that the snapshot
+    // includes the edits. Returns true if any edits were applied. Edits to
+    // values that no longer exist are dropped.
+    bool ApplyEdits(T& value)
+    {
+        const std::size_t count = edits.Apply(value);
+        applied += count;
+        return count != 0;
+    }
+
+private:
+    friend bool Input<T>(const char* name, Watched<T>& watched);
+
+    // The latest buffer is packed with whether it is newer than the one the UI
+    // holds and the number of edits applied when it was published.
+    static constexpr std::uint64_t pack(std::size_t index, bool fresh, std::uint64_t stamp)
+    {
+        return (stamp << 3) | (fresh ? 4 : 0) | index;
+    }
+    static constexpr std::size_t index_of(std::uint64_t state) { return state & 3; }
+    static constexpr bool fresh_of(std::uint64_t state) { return state & 4; }
+    static constexpr std::uint64_t stamp_of(std::uint64_t state) { return state >> 3; }
+
+    // Returns the snapshot for the UI to render, taking the latest one if it
+    // includes every edit sent so far. Stamps only increase, so if the latest
+    // buffer qualifies when loaded, whatever the exchange returns does too.
+    T& acquire()
+    {
+        const std::uint64_t state = latest.load(std::memory_order_acquire);
+        if (fresh_of(state) && stamp_of(state) >= sent) {
+            front = index_of(latest.exchange(pack(front, false, 0), std::memory_order_acq_rel));
+        }
+        return buffers[front];
+    }
+
+    void send(std::vector<detail::patch>& recorded)
+    {
+        sent += recorded.size();
+        edits.push(recorded);
+    }
+
+    T                          buffers[3] = {};
+    std::atomic<std::uint64_t> latest = pack(1, false, 0);
+    std::size_t                back   = 0; // Owned by the owner
+    std::size_t                front  = 2; // Owned by the UI
+    std::uint64_t              applied = 0; // Owned by the owner
+    std::uint64_t              sent    = 0; // Owned by the UI
+    EditQueue                  edits;
+};
+
 template <Config config, typename T>
 bool Input(const char* name, T&& value)
 {
-    using Type = [:remove_cvref(^^T):];
     ImGui::PushID(name);
-    const bool changed = Renderer<config, Type>::Render(name, std::forward<T>(value));
+    const bool changed = detail::render<config>(name, std::forward<T>(value));
     ImGui::PopID();
     return changed;
 }
@@ -94,21 +579,120 @@ bool Input(const char* name, T&& value)
     return Input<config>(name, std::forward<T>(value));
 }
 
+// Equivalent to Input, but also adds the paths of the values that were
+// modified to the given ChangeSet. Nothing is allocated when nothing changes.
+template <typename T>
+bool Input(const char* name, T&& value, ChangeSet& changes)
+{
+    auto& recorder = detail::recorder();
+    ChangeSet* const previous_target = std::exchange(recorder.target, &changes);
+    const std::size_t previous_base = std::exchange(recorder.base, recorder.path.size());
+    const bool changed = Input(name, std::forward<T>(value));
+    recorder.target = previous_target;
+    recorder.base = previous_base;
+    return changed;
+}
+
+// Equivalent to Input, but also records the edits that are made into the given
+// History so that they can be undone.
+template <typename T>
+bool Input(const char* name, T& value, History& history)
+{
+    static_assert(!std::is_const_v<T>, "a const value cannot be edited");
+    auto& recorder = detail::recorder();
+    History* const previous_history = std::exchange(recorder.history, &history);
+    void* const previous_root = std::exchange(recorder.root, std::addressof(value));
+    const auto previous_locate = std::exchange(recorder.locate, &detail::locate_root<T>);
+    const bool previous_in_leaf = std::exchange(recorder.in_leaf, false);
+    const std::size_t previous_base = std::exchange(recorder.base, recorder.path.size());
+    const bool changed = Input(name, value);
+    recorder.history = previous_history;
+    recorder.root = previous_root;
+    recorder.locate = previous_locate;
+    recorder.in_leaf = previous_in_leaf;
+    recorder.base = previous_base;
+    return changed;
+}
+
+namespace detail {
+
+// Renders a value, collecting the edits made to it as commands rather than
+// recording them into a History.
+template <typename T>
+bool render_commands(const char* name, T& value, std::vector<patch>& edits)
+{
+    static_assert(!std::is_const_v<T>, "a const value cannot be edited");
+    auto& state = recorder();
+    History* const previous_history = std::exchange(state.history, nullptr);
+    auto* const previous_edits = std::exchange(state.edits, &edits);
+    void* const previous_root = std::exchange(state.root, std::addressof(value));
+    const auto previous_locate = std::exchange(state.locate, &locate_root<T>);
+    const bool previous_in_leaf = std::exchange(state.in_leaf, false);
+    const std::size_t previous_base = std::exchange(state.base, state.path.size());
+    const bool changed = Input(name, value);
+    state.history = previous_history;
+    state.edits = previous_edits;
+    state.root = previous_root;
+    state.locate = previous_locate;
+    state.in_leaf = previous_in_leaf;
+    state.base = previous_base;
+    return changed;
+}
+
+} // namespace detail
+
+// Renders a value, such as the UI thread's copy of an object owned by another
+// thread, and pushes the edits made to it onto the given EditQueue for the
+// owner to apply. Edits that cannot be recorded in a History are not sent.
+template <typename T>
+bool Input(const char* name, T& value, EditQueue& queue)
+{
+    std::vector<detail::patch> edits;
+    const bool changed = detail::render_commands(name, value, edits);
+    queue.push(edits);
+    return changed;
+}
+
+// Renders the latest snapshot of a Watched value on the UI thread. Edits are
+// made to the snapshot and sent to the owner, who applies them to its value
+// with ApplyEdits. Edits that cannot be recorded in a History are not sent.
+template <typename T>
+bool Input(const char* name, Watched<T>& watched)
+{
+    T& snapshot = watched.acquire();
+    std::vector<detail::patch> edits;
+    const bool changed = detail::render_commands(name, snapshot, edits);
+    watched.send(edits);
+    return changed;
+}
+
+// Instantiating Input for a large type is expensive. To do it in only one
+// translation unit, use IMREFL_EXTERN_INPUT(type) in a header included before
+// any calls, and IMREFL_INSTANTIATE_INPUT(type) in a single source file. Both
+// must be used at global namespace scope and cover mutable and const lvalues.
+#define IMREFL_EXTERN_INPUT(...)                                                             \
+    extern template bool ::ImRefl::Input<__VA_ARGS__&>(const char*, __VA_ARGS__&);          \
+    extern template bool ::ImRefl::Input<const __VA_ARGS__&>(const char*, const __VA_ARGS__&)
+
+#define IMREFL_INSTANTIATE_INPUT(...)                                                 \
+    template bool ::ImRefl::Input<__VA_ARGS__&>(const char*, __VA_ARGS__&);          \
+    template bool ::ImRefl::Input<const __VA_ARGS__&>(const char*, const __VA_ARGS__&)
+
 // ============================================================================
 // LIBRARY ANNOTATIONS
 // ============================================================================
 
 struct Ignore {};
-inline static constexpr Ignore ignore {};
+inline constexpr Ignore ignore {};
 
 struct Readonly {};
-inline static constexpr Readonly readonly {};
+inline constexpr Readonly readonly {};
 
 struct InLine {};
-inline static constexpr InLine in_line {};
+inline constexpr InLine in_line {};
 
 struct NonResizable {};
-inline static constexpr NonResizable non_resizable {};
+inline constexpr NonResizable non_resizable {};
 
 struct Separator { const char* title; };
 consteval Separator separator(std::string_view title = "") { return {std::define_static_string(title)}; }
@@ -120,10 +704,10 @@ struct EndRegion { std::size_t levels; };
 constexpr EndRegion end_region(std::size_t levels = 1) { return {levels}; }
 
 struct Color {};
-inline static constexpr Color color {};
+inline constexpr Color color {};
 
 struct ColorWheel {};
-inline static constexpr ColorWheel color_wheel {};
+inline constexpr ColorWheel color_wheel {};
 
 struct Slider { int min; int max; };
 constexpr Slider slider(int min, int max) { return {min, max}; }
@@ -132,10 +716,47 @@ struct Drag { int min; int max; float speed; };
 constexpr Drag drag(int min, int max, float speed = 1.0f) { return {min, max, speed}; }
 
 struct String {};
-inline static constexpr String string {};
+inline constexpr String string {};
 
 struct Radio {};
-inline static constexpr Radio radio {};
+inline constexpr Radio radio {};
+
+struct Clipped {};
+inline constexpr Clipped clipped {};
+
+struct Table {};
+inline constexpr Table table {};
+
+struct Plot { bool histogram; float height; };
+constexpr Plot plot(float height = 80.0f) { return {false, height}; }
+constexpr Plot histogram(float height = 80.0f) { return {true, height}; }
+
+struct Multiline { int lines; };
+constexpr Multiline multiline(int lines = 16) { return {lines}; }
+
+struct Hex {};
+inline constexpr Hex hex {};
+
+struct Paged { int page_size; std::size_t checkpoint_stride; };
+constexpr Paged paged(int page_size = 100, std::size_t checkpoint_stride = 1024) { return {page_size, checkpoint_stride}; }
+
+// The function is called as std::invoke(fn, parent, member) after the member
+// is modified, so it may also be a pointer to a member function of the parent.
+template <typename F>
+struct OnChange { F fn; };
+template <typename F>
+constexpr OnChange<F> on_change(F fn) { return {fn}; }
+
+struct SampleEvery { int milliseconds; };
+constexpr SampleEvery sample_every(int milliseconds) { return {milliseconds}; }
+
+// May also be applied to a type, to highlight all of its data members.
+struct HighlightChanges { float fade_seconds; };
+constexpr HighlightChanges highlight_changes(float fade_seconds = 1.0f) { return {fade_seconds}; }
+
+// Applied to a type rather than a data member.
+struct TableDriven {};
+inline constexpr TableDriven table_driven {};
 
 // ============================================================================
 // LIBRARY UTILITY 
@@ -262,6 +883,45 @@ static_assert(is_swappable<std::vector<int>>);
 static_assert(!is_swappable<const std::vector<int>>);
 static_assert(!is_swappable<std::unordered_map<int, int>>);
 
+template <typename R>
+concept clippable =
+    std::ranges::random_access_range<R> &&
+    std::ranges::sized_range<R>;
+
+static_assert(clippable<std::vector<int>>);
+static_assert(clippable<std::span<const int>>);
+static_assert(!clippable<std::map<int, int>>);
+
+template <typename R>
+concept plottable =
+    std::ranges::contiguous_range<R> &&
+    std::ranges::sized_range<R> &&
+    scalar<std::ranges::range_value_t<R>>;
+
+static_assert(plottable<std::vector<double>>);
+static_assert(plottable<std::span<const float>>);
+static_assert(!plottable<std::set<float>>);
+
+template <typename T>
+concept byte_like =
+    sizeof(T) == 1 &&
+    (std::same_as<std::remove_cv_t<T>, std::byte> || scalar<std::remove_cv_t<T>>);
+
+template <typename R>
+concept byte_range =
+    std::ranges::contiguous_range<R> &&
+    std::ranges::sized_range<R> &&
+    byte_like<std::ranges::range_value_t<R>>;
+
+static_assert(byte_range<std::vector<std::uint8_t>>);
+static_assert(byte_range<std::span<const std::byte>>);
+static_assert(!byte_range<std::vector<int>>);
+
+template <typename R>
+concept table_range =
+    clippable<R> &&
+    aggregate<std::ranges::range_value_t<R>>;
+
 // INTERNAL HELPERS
 
 consteval auto nsdm_of(std::meta::info type)
@@ -270,6 +930,13 @@ consteval auto nsdm_of(std::meta::info type)
 	return std::define_static_array(nonstatic_data_members_of(type, ctx));
 }
 
+// The direct base classes of a type. Those of aggregates are always public.
+consteval auto bases_of_type(std::meta::info type)
+{
+    const auto ctx = std::meta::access_context::current();
+    return std::define_static_array(bases_of(type, ctx));
+}
+
 consteval std::vector<std::meta::info> external_attns(
     std::meta::info parent, std::meta::info member)
 {
@@ -290,50 +957,249 @@ consteval auto get_all_attns(std::meta::info parent, std::meta::info member)
         attns.push_back(attn);
     }
 
-    return std::define_static_array(attns);
+    return attns;
 }
 
-consteval auto integer_sequence(std::size_t max)
+// Builds a Config in a canonical form so that members with equal annotations
+// share Renderer instantiations, even across types. Annotations are replaced
+// by reflections of their values, only the first of each type is kept (which
+// is the one FetchAttn would find) and they are ordered by type name. Equal
+// contents give the same static array, and no annotations give Config{}.
+consteval Config make_config(std::span<const std::meta::info> attns)
 {
-    std::vector<std::size_t> values(max);
-    std::iota(values.begin(), values.end(), 0);
-    return std::define_static_array(values);
+    std::vector<std::meta::info> values;
+    for (const auto attn : attns) {
+        const auto type = remove_cvref(type_of(attn));
+        const bool seen = std::ranges::any_of(values, [&](std::meta::info value) {
+            return remove_cvref(type_of(value)) == type;
+        });
+        if (!seen) {
+            values.push_back(constant_of(attn));
+        }
+    }
+
+    if (values.empty()) {
+        return {};
+    }
+
+    std::ranges::stable_sort(values, {}, [](std::meta::info value) {
+        return display_string_of(remove_cvref(type_of(value)));
+    });
+    const auto canonical = std::define_static_array(values);
+    return {canonical.data(), canonical.size()};
 }
 
-consteval auto enums_of(std::meta::info type)
+consteval Config member_config(std::meta::info parent, std::meta::info member)
 {
-    return std::define_static_array(enumerators_of(type));
+    return make_config(get_all_attns(parent, member));
 }
 
-template <enumeration T>
-constexpr const char* enum_to_string(T value)
+// ImHashStr is a CRC32 over the string; ImGui switched from the zlib polynomial
+// to the Castagnoli one (usable with SSE 4.2) in 1.91.6.
+#if defined(IMGUI_USE_LEGACY_CRC32_ADLER) || IMGUI_VERSION_NUM < 19160
+inline constexpr ImU32 crc32_polynomial = 0xEDB88320;
+#else
+inline constexpr ImU32 crc32_polynomial = 0x82F63B78;
+#endif
+
+consteval std::array<ImU32, 256> crc32_table()
 {
-    template for (constexpr auto e : enums_of(^^T)) {
-        if (value == [:e:]) {
-            return identifier_of(e).data();
+    std::array<ImU32, 256> table = {};
+    for (ImU32 i = 0; i != 256; ++i) {
+        ImU32 crc = i;
+        for (int bit = 0; bit != 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ crc32_polynomial : crc >> 1;
         }
+        table[i] = crc;
     }
-    return "<unnamed>";
+    return table;
 }
 
-template <scalar T>
-consteval auto num_type()
+// A string hashed at compile time such that with_seed gives the same ImGuiID
+// as ImHashStr would at runtime. CRC32 is linear, so the hash of a string from
+// any seed is the hash from a zero register XORed with the effect of shifting
+// the seed through as many zero bytes; the latter is stored per seed bit.
+struct static_id
 {
-    if constexpr (std::signed_integral<T>) {
-        switch (sizeof(T)) {
-            case 1: return ImGuiDataType_S8;
-            case 2: return ImGuiDataType_S16;
-            case 4: return ImGuiDataType_S32;
-            case 8: return ImGuiDataType_S64;
+    ImU32 crc;
+    ImU32 shift[32];
+
+    ImGuiID with_seed(ImGuiID seed) const
+    {
+        const ImU32 reg = ~seed;
+        ImU32 result = crc;
+        for (int bit = 0; bit != 32; ++bit) {
+            result ^= shift[bit] & (0u - ((reg >> bit) & 1u));
         }
+        return ~result;
     }
-    else if constexpr (std::unsigned_integral<T>) {
-        switch (sizeof(T)) {
-            case 1: return ImGuiDataType_U8;
-            case 2: return ImGuiDataType_U16;
-            case 4: return ImGuiDataType_U32;
-            case 8: return ImGuiDataType_U64;
-        }
+};
+
+consteval static_id make_static_id(std::string_view str)
+{
+    if (str.contains("###")) {
+        throw "static ids do not support the ### operator";
+    }
+
+    constexpr auto table = crc32_table();
+    const auto step = [&](ImU32 crc, unsigned char c) { return (crc >> 8) ^ table[(crc & 0xFF) ^ c]; };
+
+    static_id id = {};
+    for (const char c : str) {
+        id.crc = step(id.crc, static_cast<unsigned char>(c));
+    }
+    for (int bit = 0; bit != 32; ++bit) {
+        ImU32 reg = 1u << bit;
+        for (std::size_t i = 0; i != str.size(); ++i) {
+            reg = step(reg, 0);
+        }
+        id.shift[bit] = reg;
+    }
+    return id;
+}
+
+template <std::meta::info member>
+inline constexpr static_id member_id = make_static_id(identifier_of(member));
+
+// Returns the annotation of type A on the type, or on the ExternalAnnotations
+// specialization for it.
+template <typename A>
+consteval std::optional<A> fetch_type_attn(std::meta::info type)
+{
+    auto attns = annotations_of(type);
+    for (const auto attn : annotations_of(substitute(^^ExternalAnnotations, {type}))) {
+        attns.push_back(attn);
+    }
+    for (const auto attn : attns) {
+        if (remove_cvref(type_of(attn)) == ^^A) {
+            return std::meta::extract<A>(attn);
+        }
+    }
+    return {};
+}
+
+template <typename A>
+consteval bool has_type_attn(std::meta::info type)
+{
+    return fetch_type_attn<A>(type).has_value();
+}
+
+consteval auto integer_sequence(std::size_t max)
+{
+    std::vector<std::size_t> values(max);
+    std::iota(values.begin(), values.end(), 0);
+    return std::define_static_array(values);
+}
+
+template <typename U>
+struct enum_entry
+{
+    U           value;
+    const char* name;
+};
+
+// Returns the value and name of each enumerator of T in declaration order.
+template <enumeration T>
+consteval auto enum_entries()
+{
+    using U = std::underlying_type_t<T>;
+    std::vector<enum_entry<U>> entries;
+    for (const auto e : enumerators_of(^^T)) {
+        entries.push_back({static_cast<U>(std::meta::extract<T>(e)), std::define_static_string(identifier_of(e))});
+    }
+    return std::define_static_array(entries);
+}
+
+// Returns the enumerators of T sorted by value. Where several enumerators
+// share a value, only the first declared one is kept.
+template <enumeration T>
+consteval auto sorted_enum_entries()
+{
+    using U = std::underlying_type_t<T>;
+    const auto declared = enum_entries<T>();
+
+    std::vector<std::size_t> order(declared.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, [&](std::size_t a, std::size_t b) {
+        if (declared[a].value != declared[b].value) {
+            return declared[a].value < declared[b].value;
+        }
+        return a < b;
+    });
+
+    std::vector<enum_entry<U>> sorted;
+    for (const auto i : order) {
+        if (sorted.empty() || sorted.back().value != declared[i].value) {
+            sorted.push_back(declared[i]);
+        }
+    }
+    return std::define_static_array(sorted);
+}
+
+// Returns true if the distinct values of the enumerators of T have no gaps, in
+// which case the sorted entries double as a table indexed by value.
+template <enumeration T>
+consteval bool enum_is_contiguous()
+{
+    const auto sorted = sorted_enum_entries<T>();
+    for (std::size_t i = 1; i < sorted.size(); ++i) {
+        if (sorted[i].value != sorted[i - 1].value + 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The unsigned type used to index the names of a contiguous enum. There is no
+// make_unsigned for bool, so enums based on it use unsigned char.
+template <typename U>
+using enum_index_t = typename std::conditional_t<
+    std::same_as<U, bool>, std::type_identity<unsigned char>, std::make_unsigned<U>>::type;
+
+template <enumeration T>
+constexpr const char* enum_to_string(T value)
+{
+    using U = std::underlying_type_t<T>;
+    using Unsigned = enum_index_t<U>;
+    constexpr auto sorted = sorted_enum_entries<T>();
+    const auto raw = static_cast<U>(value);
+
+    if constexpr (sorted.empty()) {
+        return "<unnamed>";
+    }
+    else if constexpr (enum_is_contiguous<T>()) {
+        const auto index = static_cast<Unsigned>(static_cast<Unsigned>(raw) - static_cast<Unsigned>(sorted.front().value));
+        if (index < sorted.size()) {
+            return sorted[index].name;
+        }
+    }
+    else {
+        const auto it = std::ranges::lower_bound(sorted, raw, {}, &enum_entry<U>::value);
+        if (it != sorted.end() && it->value == raw) {
+            return it->name;
+        }
+    }
+    return "<unnamed>";
+}
+
+template <scalar T>
+consteval auto num_type()
+{
+    if constexpr (std::signed_integral<T>) {
+        switch (sizeof(T)) {
+            case 1: return ImGuiDataType_S8;
+            case 2: return ImGuiDataType_S16;
+            case 4: return ImGuiDataType_S32;
+            case 8: return ImGuiDataType_S64;
+        }
+    }
+    else if constexpr (std::unsigned_integral<T>) {
+        switch (sizeof(T)) {
+            case 1: return ImGuiDataType_U8;
+            case 2: return ImGuiDataType_U16;
+            case 4: return ImGuiDataType_U32;
+            case 8: return ImGuiDataType_U64;
+        }
     }
     else if constexpr (std::floating_point<T>) {
         switch (sizeof(T)) {
@@ -341,37 +1207,1407 @@ consteval auto num_type()
             case 8: return ImGuiDataType_Double;
         }
     }
-    throw "unknown scalar type";
+    throw "unknown scalar type";
+}
+
+inline bool square_button(const char* name)
+{
+    const float button_size = ImGui::GetFrameHeight();
+    return ImGui::Button(name, {button_size, button_size});
+}
+
+// Returns the deepest nesting of regions created by begin_region annotations
+// on the members of the given type.
+consteval std::size_t max_region_depth(std::meta::info type)
+{
+    std::size_t depth = 0;
+    std::size_t max_depth = 0;
+    for (const auto member : nsdm_of(type)) {
+        const auto config = member_config(type, member);
+        if (const auto er = config.FetchAttn<EndRegion>()) {
+            depth = (er->levels == 0 || er->levels > depth) ? 0 : depth - er->levels;
+        }
+        if (config.HasAttn<BeginRegion>()) {
+            max_depth = std::max(max_depth, ++depth);
+        }
+    }
+    return max_depth;
+}
+
+// A fixed capacity stack of the open/closed state of the regions within an
+// aggregate. The capacity comes from max_region_depth so that rendering an
+// aggregate never allocates.
+template <std::size_t N>
+struct region_stack
+{
+    std::array<bool, N> states = {};
+    std::size_t         size   = 0;
+
+    // Returns true if the members at the current position should be shown
+    bool visible() const
+    {
+        return size == 0 || states[size - 1];
+    }
+
+    void begin(const char* title)
+    {
+        states[size] = visible() && TreeNodeExNoDisable(title);
+        ++size;
+    }
+
+    // Closes the given number of regions, or all of them if levels is 0.
+    void end(std::size_t levels)
+    {
+        std::size_t closed = 0;
+        while (size != 0) {
+            if (states[--size]) {
+                ImGui::TreePop();
+            }
+            if (++closed == levels) {
+                break;
+            }
+        }
+    }
+
+    void end_all()
+    {
+        end(0);
+    }
+};
+
+// Appends an index to the current change path for its lifetime, if changes are
+// being recorded.
+struct path_scope
+{
+    bool active;
+
+    explicit path_scope(std::size_t index)
+        : active(recorder().target != nullptr || recorder().history != nullptr)
+    {
+        if (active) {
+            recorder().path.push_back(static_cast<std::uint32_t>(index));
+        }
+    }
+
+    ~path_scope()
+    {
+        if (active) {
+            recorder().path.pop_back();
+        }
+    }
+
+    path_scope(const path_scope&) = delete;
+    path_scope& operator=(const path_scope&) = delete;
+};
+
+// Stops recording changes for its lifetime, for widgets that edit something
+// other than the value passed to Input.
+struct untracked_scope
+{
+    ChangeSet* previous_target;
+    History*   previous_history;
+
+    untracked_scope()
+        : previous_target(std::exchange(recorder().target, nullptr))
+        , previous_history(std::exchange(recorder().history, nullptr))
+    {}
+
+    ~untracked_scope()
+    {
+        recorder().target = previous_target;
+        recorder().history = previous_history;
+    }
+
+    untracked_scope(const untracked_scope&) = delete;
+    untracked_scope& operator=(const untracked_scope&) = delete;
+};
+
+inline std::size_t change_mark()
+{
+    const auto& state = recorder();
+    return state.target ? state.target->Size() : 0;
+}
+
+// Records the current path as changed, unless something below it has been
+// recorded since the mark was taken.
+inline void record_change(std::size_t mark)
+{
+    auto& state = recorder();
+    if (state.target && state.target->Size() == mark) {
+        state.target->Add(std::span<const std::uint32_t>{state.path}.subspan(state.base));
+    }
+}
+
+// Records the value being rendered as changed regardless of its children, for
+// modifications such as resizing a container.
+inline void record_current_change()
+{
+    ++structure_generation();
+    record_change(change_mark());
+}
+
+// The largest trivially copyable value that is snapshotted as a whole for the
+// History rather than through its members or elements.
+inline constexpr std::size_t max_leaf_snapshot = 256;
+
+template <typename T, std::meta::info tmpl>
+concept specialization_of =
+    has_template_arguments(^^T) &&
+    template_of(^^T) == tmpl;
+
+// Values that are copied before they are rendered so that their edits can be
+// recorded in a History. Pointers and views are excluded because their
+// Renderers edit what they refer to rather than themselves.
+template <typename T>
+concept history_leaf =
+    std::same_as<T, std::string> ||
+    (std::is_trivially_copyable_v<T> &&
+     (std::is_array_v<T> || std::is_trivially_copy_assignable_v<T>) &&
+     sizeof(T) <= max_leaf_snapshot &&
+     !std::is_pointer_v<T> &&
+     !std::ranges::view<T> &&
+     !specialization_of<T, ^^std::reference_wrapper>);
+
+// Returns true if edits are being recorded, either into a History or to be
+// sent to the owner of a Watched value.
+inline bool history_enabled()
+{
+    const auto& state = recorder();
+    return (state.history != nullptr || state.edits != nullptr) && !state.in_leaf;
+}
+
+// Counts the frames on which a widget was activated, so that edits made during
+// one activation of a widget are not merged with those of the next.
+inline std::uint64_t& activation_count()
+{
+    static std::uint64_t count = 0;
+    return count;
+}
+
+inline void count_activation()
+{
+    static int counted_frame = -1;
+    const ImGuiContext& g = *ImGui::GetCurrentContext();
+    if (g.ActiveIdIsJustActivated && counted_frame != g.FrameCount) {
+        ++activation_count();
+        counted_frame = g.FrameCount;
+    }
+}
+
+// The History leaves that contained the hovered, active and nav focused items,
+// in the current and previous frames. Only these can be edited, as a widget
+// must have been hovered or focused before input reaches it.
+struct hot_leaves
+{
+    ImGuiID current[3]  = {};
+    ImGuiID previous[3] = {};
+    int     frame       = -1;
+
+    bool contains(ImGuiID id) const
+    {
+        return std::ranges::contains(previous, id) || std::ranges::contains(current, id);
+    }
+};
+
+inline hot_leaves& hot_leaf_state()
+{
+    static hot_leaves state;
+    return state;
+}
+
+// The interaction state of ImGui before a leaf is rendered. Comparing it with
+// the state afterwards shows which of the items a leaf submitted.
+struct leaf_watch
+{
+    ImGuiID hovered;
+    ImGuiID active_alive;
+    bool    nav_alive;
+
+    leaf_watch()
+    {
+        const ImGuiContext& g = *ImGui::GetCurrentContext();
+        hovered = g.HoveredId;
+        active_alive = g.ActiveIdIsAlive;
+        nav_alive = g.NavIdIsAlive;
+    }
+
+    void update(ImGuiID leaf) const
+    {
+        const ImGuiContext& g = *ImGui::GetCurrentContext();
+        auto& state = hot_leaf_state();
+        if (g.HoveredId != 0 && g.HoveredId != hovered) {
+            state.current[0] = leaf;
+        }
+        if (g.ActiveIdIsAlive != 0 && g.ActiveIdIsAlive != active_alive) {
+            state.current[1] = leaf;
+        }
+        if (g.NavIdIsAlive && !nav_alive) {
+            state.current[2] = leaf;
+        }
+    }
+};
+
+// Returns true if there is input this frame that could lead to an edit of the
+// given leaf, so that values are only snapshotted when they might change. On
+// frames without new input, that is only the leaf holding the active item.
+inline bool edit_possible(ImGuiID leaf)
+{
+    const ImGuiContext& g = *ImGui::GetCurrentContext();
+    auto& state = hot_leaf_state();
+    if (state.frame != g.FrameCount) {
+        std::ranges::copy(state.current, state.previous);
+        std::ranges::fill(state.current, 0);
+        state.frame = g.FrameCount;
+    }
+
+    // New input can activate and edit an item within one frame, even an item
+    // that could not be hovered last frame because another item was active
+    if (g.NavActivateId != 0 || !g.IO.InputQueueCharacters.empty()) {
+        return true;
+    }
+    for (int button = 0; button != ImGuiMouseButton_COUNT; ++button) {
+        if (g.IO.MouseClicked[button] || g.IO.MouseReleased[button]) {
+            return true;
+        }
+    }
+    for (const ImGuiInputEvent& event : g.InputEventsTrail) {
+        if (event.Type == ImGuiInputEventType_Key || event.Type == ImGuiInputEventType_MouseButton) {
+            return true;
+        }
+    }
+
+    // Otherwise only an item that is already active, such as a slider being
+    // dragged, can change
+    return g.ActiveId != 0 && state.contains(leaf);
+}
+
+// The state of a value before and after an edit. Trivially copyable values
+// are stored as bytes, everything else as a copy.
+template <typename T>
+struct value_patch final : patch_data
+{
+    static constexpr bool as_bytes = std::is_trivially_copyable_v<T>;
+    using state = std::conditional_t<as_bytes, std::array<std::byte, sizeof(T)>, T>;
+
+    state before;
+    state after;
+
+    static state capture(const T& value)
+    {
+        if constexpr (as_bytes) {
+            state bytes;
+            std::memcpy(bytes.data(), std::addressof(value), sizeof(T));
+            return bytes;
+        } else {
+            return value;
+        }
+    }
+
+    bool apply(const patch& entry, bool undo) override
+    {
+        T* target = entry.find<T>();
+        if (!target) {
+            return false;
+        }
+        const state& from = undo ? before : after;
+        if constexpr (as_bytes) {
+            std::memcpy(target, from.data(), sizeof(T));
+        } else {
+            *target = from;
+        }
+        return true;
+    }
+
+    void merge(patch_data& newer) override
+    {
+        after = std::move(static_cast<value_patch&>(newer).after);
+    }
+};
+
+enum class range_op
+{
+    push_back,
+    pop_back,
+    push_front,
+    pop_front,
+    erase,
+    emplace,
+};
+
+// A change to the elements of a container, storing at most the one element
+// that was added or removed.
+template <typename R, range_op op>
+struct range_patch final : patch_data
+{
+    std::size_t                                   index = 0;
+    std::optional<std::ranges::range_value_t<R>> element;
+
+    bool apply(const patch& entry, bool undo) override
+    {
+        R* range = entry.find<R>();
+        if (!range) {
+            return false;
+        }
+
+        if constexpr (op == range_op::push_back || op == range_op::pop_back) {
+            if ((op == range_op::push_back) == undo) {
+                range->pop_back();
+            } else if (element) {
+                range->emplace_back(*element);
+            } else {
+                range->emplace_back();
+            }
+        }
+        else if constexpr (op == range_op::push_front || op == range_op::pop_front) {
+            if ((op == range_op::push_front) == undo) {
+                range->pop_front();
+            } else if (element) {
+                range->emplace_front(*element);
+            } else {
+                range->emplace_front();
+            }
+        }
+        else if constexpr (op == range_op::erase) {
+            const auto it = std::ranges::next(range->begin(), index);
+            if (undo) {
+                range->insert(it, *element);
+            } else {
+                range->erase(it);
+            }
+        }
+        else if constexpr (op == range_op::emplace) {
+            if (undo) {
+                const auto it = [&] {
+                    if constexpr (is_map_type<R>) {
+                        return range->find(element->first);
+                    } else {
+                        return range->find(*element);
+                    }
+                }();
+                if (it == range->end()) {
+                    return false;
+                }
+                range->erase(it);
+            } else {
+                range->insert(*element);
+            }
+        }
+        return true;
+    }
+};
+
+// Two elements of a random access range swapped by drag and drop. The elements
+// are found through their own paths, as arrays are rendered as spans.
+template <typename T>
+struct swap_patch final : patch_data
+{
+    std::uint32_t first;
+    std::uint32_t second;
+
+    bool apply(const patch& entry, bool) override
+    {
+        T* a = entry.find<T>({first});
+        T* b = entry.find<T>({second});
+        if (!a || !b) {
+            return false;
+        }
+        std::ranges::swap(*a, *b);
+        return true;
+    }
+};
+
+struct history_recorder
+{
+    static void push(std::unique_ptr<patch_data> data, ImGuiID active_id)
+    {
+        auto& state = recorder();
+        const auto path = std::span<const std::uint32_t>{state.path}.subspan(state.base);
+        const std::uint64_t activation = active_id != 0 ? activation_count() : 0;
+        auto entry = patch{state.root, state.locate, std::vector<std::uint32_t>(path.begin(), path.end()), active_id, activation, std::move(data)};
+        if (state.history) {
+            state.history->push(std::move(entry));
+        } else {
+            state.edits->push_back(std::move(entry));
+        }
+    }
+};
+
+// Records an operation about to be (or just) applied to the range being
+// rendered, along with the element it adds or removes, if any.
+template <range_op op, typename R, typename... Element>
+void record_range_op(R&, std::size_t index, const Element&... element)
+{
+    if constexpr (std::copy_constructible<std::ranges::range_value_t<R>>) {
+        if (history_enabled()) {
+            auto data = std::make_unique<range_patch<R, op>>();
+            data->index = index;
+            (data->element.emplace(element), ...);
+            history_recorder::push(std::move(data), 0);
+        }
+    }
+}
+
+template <std::ranges::random_access_range R>
+void record_swap(R&, std::size_t first, std::size_t second)
+{
+    using Element = std::remove_cvref_t<std::ranges::range_reference_t<R>>;
+    if constexpr (std::is_lvalue_reference_v<std::ranges::range_reference_t<R>>) {
+        if (history_enabled()) {
+            auto data = std::make_unique<swap_patch<Element>>();
+            data->first = static_cast<std::uint32_t>(first);
+            data->second = static_cast<std::uint32_t>(second);
+            history_recorder::push(std::move(data), 0);
+        }
+    }
+}
+
+// Records a change to a value as a whole, for edits such as engaging or
+// resetting a std::optional whose payload is not snapshotted as a leaf. Edits
+// made while the given widget stays active are merged.
+template <typename T>
+void record_value_change(const T& before, const T& after, ImGuiID active_id = 0)
+{
+    if constexpr (std::copy_constructible<T> && std::is_copy_assignable_v<T>) {
+        if (history_enabled()) {
+            auto data = std::make_unique<value_patch<T>>();
+            data->before = value_patch<T>::capture(before);
+            data->after = value_patch<T>::capture(after);
+            history_recorder::push(std::move(data), active_id);
+        }
+    }
+}
+
+// The alternative of a variant being replaced with a value initialized one.
+// The previous value is stored if it can be copied, so that it can be undone.
+template <typename V, std::size_t index>
+struct variant_patch final : patch_data
+{
+    std::optional<V> before;
+
+    bool apply(const patch& entry, bool undo) override
+    {
+        V* variant = entry.find<V>();
+        if (!variant) {
+            return false;
+        }
+        if (undo) {
+            if constexpr (std::is_copy_assignable_v<V>) {
+                if (before) {
+                    *variant = *before;
+                    return true;
+                }
+            }
+            return false;
+        }
+        variant->template emplace<index>();
+        return true;
+    }
+};
+
+template <std::size_t index, typename V>
+void record_variant_emplace(const V& variant)
+{
+    if (history_enabled()) {
+        auto data = std::make_unique<variant_patch<V, index>>();
+        if constexpr (std::copy_constructible<V>) {
+            data->before.emplace(variant);
+        }
+        history_recorder::push(std::move(data), 0);
+    }
+}
+
+// A std::expected being switched between holding a value and an error, each
+// value initialized. The previous state is stored if it can be copied.
+template <typename X, bool to_value>
+struct expected_patch final : patch_data
+{
+    std::optional<X> before;
+
+    bool apply(const patch& entry, bool undo) override
+    {
+        X* expected = entry.find<X>();
+        if (!expected) {
+            return false;
+        }
+        if (undo) {
+            if constexpr (std::is_copy_assignable_v<X>) {
+                if (before) {
+                    *expected = *before;
+                    return true;
+                }
+            }
+            return false;
+        }
+        if constexpr (to_value) {
+            *expected = typename X::value_type{};
+        } else {
+            *expected = std::unexpected(typename X::error_type{});
+        }
+        return true;
+    }
+};
+
+template <bool to_value, typename X>
+void record_expected_switch(const X& expected)
+{
+    if (history_enabled()) {
+        auto data = std::make_unique<expected_patch<X, to_value>>();
+        if constexpr (std::copy_constructible<X>) {
+            data->before.emplace(expected);
+        }
+        history_recorder::push(std::move(data), 0);
+    }
+}
+
+// Stores an object of type T in static storage and implements a popup
+// box for modifying the value. Returns a std::optional<T> containing the
+// produced value when the user clicks the Add button.
+template <Config config, std::default_initializable T>
+std::optional<T> get_new_value()
+{
+    static T value {};
+    if (square_button("+##get_new_value")) {
+        ImGui::OpenPopup("emplace_popup");
+    }
+
+    auto return_val = std::optional<T>{};
+    if (ImGui::BeginPopup("emplace_popup")) {
+        const untracked_scope untracked;
+        Input<config>("[new key]", value);
+        if (ImGui::Button("Add")) {
+            ImGui::CloseCurrentPopup();
+            return_val = value;        
+            value = {};
+        }
+        ImGui::EndPopup();
+    }
+    return return_val;
+}
+
+// Per-widget state keyed by ID. Entries of widgets that were not drawn in the
+// previous frame are dropped, so the cache does not grow over the lifetime of
+// the application.
+template <typename T>
+class frame_cache
+{
+public:
+    T& operator[](ImGuiID id)
+    {
+        const int frame = ImGui::GetFrameCount();
+        if (pruned_frame != frame) {
+            std::erase_if(entries, [&](const auto& e) { return e.second.last_seen < frame - 1; });
+            pruned_frame = frame;
+        }
+        auto& e = entries[id];
+        e.last_seen = frame;
+        return e.value;
+    }
+
+private:
+    struct entry
+    {
+        T   value{};
+        int last_seen = 0;
+    };
+
+    std::unordered_map<ImGuiID, entry> entries;
+    int                                pruned_frame = -1;
+};
+
+// INTERNAL PROFILER
+
+#ifdef IMREFL_ENABLE_PROFILER
+
+// Accumulated cost of a Renderer type or a field path within one frame.
+struct profile_entry
+{
+    std::size_t  calls        = 0;
+    std::int64_t inclusive_ns = 0;
+    std::int64_t exclusive_ns = 0;
+    std::size_t  vertices     = 0;
+};
+
+struct profile_frame
+{
+    int                                            frame    = -1;
+    std::int64_t                                   total_ns = 0;
+    std::unordered_map<const char*, profile_entry> by_type;
+    std::unordered_map<ImGuiID, profile_entry>     by_path;
+
+    void clear()
+    {
+        frame = -1;
+        total_ns = 0;
+        by_type.clear();
+        by_path.clear();
+    }
+};
+
+struct profile_state
+{
+    struct open_scope
+    {
+        const char*  name;
+        const char*  type;
+        ImGuiID      id;
+        std::int64_t start_ns;
+        std::int64_t child_ns;
+        ImDrawList*  draw_list;
+        int          vertex_start;
+    };
+
+    profile_frame current;
+    profile_frame last;
+    profile_frame hitch;
+    float         budget_ms = 0.0f;
+
+    std::vector<open_scope>                  stack;
+    std::unordered_map<ImGuiID, std::string> path_names;
+
+    static std::int64_t now()
+    {
+        const auto since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count();
+    }
+
+    // Called at the start of each top-level Input; rolls the statistics over
+    // when ImGui has moved on to a new frame, keeping the last frame that went
+    // over budget.
+    void begin_frame()
+    {
+        const int frame = ImGui::GetFrameCount();
+        if (current.frame == frame) {
+            return;
+        }
+        if (current.frame != -1 && budget_ms > 0.0f && current.total_ns > budget_ms * 1e6f) {
+            hitch = current;
+        }
+        std::swap(last, current);
+        current.clear();
+        current.frame = frame;
+
+        // Only the names of the fields in the frames that can still be shown
+        // are kept, so that they do not grow over the lifetime of the application
+        std::erase_if(path_names, [&](const auto& entry) {
+            return !last.by_path.contains(entry.first) && !hitch.by_path.contains(entry.first);
+        });
+    }
+
+    void push(const char* name, const char* type)
+    {
+        if (stack.empty()) {
+            begin_frame();
+        }
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        const ImGuiID id = ImGui::GetCurrentWindow()->IDStack.back();
+        stack.push_back({name, type, id, now(), 0, draw_list, draw_list->VtxBuffer.Size});
+
+        if (!path_names.contains(id)) {
+            std::string path;
+            for (const auto& scope : stack) {
+                if (!path.empty()) {
+                    path += '/';
+                }
+                path += scope.name;
+            }
+            path_names.emplace(id, std::move(path));
+        }
+    }
+
+    void pop()
+    {
+        const open_scope scope = stack.back();
+        stack.pop_back();
+
+        const std::int64_t inclusive = now() - scope.start_ns;
+        const std::size_t vertices = (ImGui::GetWindowDrawList() == scope.draw_list)
+            ? static_cast<std::size_t>(scope.draw_list->VtxBuffer.Size - scope.vertex_start)
+            : 0;
+
+        for (profile_entry* entry : {&current.by_type[scope.type], &current.by_path[scope.id]}) {
+            entry->calls += 1;
+            entry->inclusive_ns += inclusive;
+            entry->exclusive_ns += inclusive - scope.child_ns;
+            entry->vertices += vertices;
+        }
+
+        if (stack.empty()) {
+            current.total_ns += inclusive;
+        } else {
+            stack.back().child_ns += inclusive;
+        }
+    }
+};
+
+inline profile_state& profiler()
+{
+    static profile_state state;
+    return state;
+}
+
+// Records the cost of a single Renderer call for the lifetime of the object.
+struct profile_scope
+{
+    profile_scope(const char* name, const char* type) { profiler().push(name, type); }
+    ~profile_scope() { profiler().pop(); }
+
+    profile_scope(const profile_scope&) = delete;
+    profile_scope& operator=(const profile_scope&) = delete;
+};
+
+#define IMREFL_PROFILE_SCOPE(name, type) ::ImRefl::detail::profile_scope imrefl_profile_scope{name, type}
+
+#else
+
+#define IMREFL_PROFILE_SCOPE(name, type)
+
+#endif
+
+// SAMPLED DISPLAY
+
+// Limits on the text cached for a sampled value, so that a large container
+// does not turn into an equally large string.
+inline constexpr std::size_t max_sampled_elements = 32;
+inline constexpr std::size_t max_sampled_length   = 4096;
+
+// Appends as much of the text as fits within max_sampled_length.
+inline void append_sampled(std::string& out, std::string_view text)
+{
+    if (out.size() < max_sampled_length) {
+        out += text.substr(0, max_sampled_length - out.size());
+    }
+}
+
+// Appends a one line description of a value to the string, such as
+// "{x: 1, y: [2, 3]}" for an aggregate. Functions taking no arguments are
+// called and their results described.
+template <typename T>
+void format_value(std::string& out, const T& value)
+{
+    if (out.size() >= max_sampled_length) {
+        return;
+    }
+
+    if constexpr (std::same_as<T, bool>) {
+        out += value ? "true" : "false";
+    }
+    else if constexpr (enumeration<T>) {
+        append_sampled(out, enum_to_string(value));
+    }
+    else if constexpr (std::is_array_v<T> && std::same_as<std::remove_cv_t<std::remove_extent_t<T>>, char>) {
+        // The array need not be null-terminated
+        out += '"';
+        append_sampled(out, std::string_view{value, strnlen(value, std::extent_v<T>)});
+        out += '"';
+    }
+    else if constexpr (std::convertible_to<const T&, std::string_view>) {
+        if constexpr (std::is_pointer_v<T>) {
+            if (!value) {
+                out += "<empty>";
+                return;
+            }
+        }
+        out += '"';
+        append_sampled(out, std::string_view{value});
+        out += '"';
+    }
+    else if constexpr (specialization_of<T, ^^std::function>) {
+        if constexpr (!std::invocable<const T&> || std::is_void_v<std::invoke_result_t<const T&>>) {
+            out += "<function>";
+        } else if (value) {
+            format_value(out, std::invoke(value));
+        } else {
+            out += "<empty>";
+        }
+    }
+    else if constexpr (specialization_of<T, ^^std::optional> ||
+                       specialization_of<T, ^^std::unique_ptr> ||
+                       specialization_of<T, ^^std::shared_ptr> ||
+                       (std::is_pointer_v<T> && std::is_object_v<std::remove_pointer_t<T>>)) {
+        if (value) {
+            format_value(out, *value);
+        } else {
+            out += "<empty>";
+        }
+    }
+    else if constexpr (specialization_of<T, ^^std::variant>) {
+        std::visit([&](const auto& alternative) { format_value(out, alternative); }, value);
+    }
+    else if constexpr (std::ranges::input_range<const T>) {
+        out += '[';
+        std::size_t count = 0;
+        for (const auto& element : value) {
+            if (count != 0) {
+                out += ", ";
+            }
+            if (count++ == max_sampled_elements) {
+                out += "...";
+                break;
+            }
+            format_value(out, element);
+        }
+        out += ']';
+    }
+    else if constexpr (std::formattable<T, char>) {
+        const auto limit = static_cast<std::ptrdiff_t>(max_sampled_length - out.size());
+        std::format_to_n(std::back_inserter(out), limit, "{}", value);
+    }
+    else if constexpr (aggregate<T>) {
+        out += '{';
+        bool first = true;
+        template for (constexpr auto member : nsdm_of(^^T)) {
+            if constexpr (!is_bit_field(member)) {
+                out += first ? "" : ", ";
+                append_sampled(out, identifier_of(member));
+                out += ": ";
+                format_value(out, value.[:member:]);
+                first = false;
+            }
+        }
+        out += '}';
+    }
+    else if constexpr (tuple_like<T>) {
+        out += '(';
+        template for (constexpr auto index : integer_sequence(tuple_size(^^T))) {
+            out += index == 0 ? "" : ", ";
+            format_value(out, std::get<index>(value));
+        }
+        out += ')';
+    }
+    else {
+        append_sampled(out, display_string_of(^^T));
+    }
+}
+
+struct sampled_entry
+{
+    std::string text;
+    double      sampled_at = -DBL_MAX;
+    int         last_seen  = 0;
+};
+
+struct sampled_state
+{
+    std::unordered_map<ImGuiID, sampled_entry> entries;
+    int                                        frame = -1;
+};
+
+inline sampled_state& sampled_values()
+{
+    static sampled_state state;
+    return state;
+}
+
+// Renders a read-only description of a value, walking the value to refresh it
+// at most once per interval. Entries for values that were not drawn in the
+// previous frame are dropped.
+template <typename T>
+void render_sampled(const char* name, const T& value, int milliseconds)
+{
+    auto& state = sampled_values();
+    const int frame = ImGui::GetFrameCount();
+    if (state.frame != frame) {
+        std::erase_if(state.entries, [&](const auto& entry) { return entry.second.last_seen < frame - 1; });
+        state.frame = frame;
+    }
+
+    auto& entry = state.entries[ImGui::GetCurrentWindow()->IDStack.back()];
+    const double now = ImGui::GetTime();
+    if (now - entry.sampled_at >= milliseconds / 1000.0) {
+        entry.text.clear();
+        format_value(entry.text, value);
+        entry.sampled_at = now;
+    }
+    entry.last_seen = frame;
+
+    ImGui::TextWrapped("%s: %s", name, entry.text.c_str());
+}
+
+// Renders a value while a History is active, recording the edit if it changes.
+// Nothing within the value records its own edits.
+template <Config config, history_leaf T>
+bool render_recorded(const char* name, T& value)
+{
+    const ImGuiID leaf = ImGui::GetCurrentWindow()->IDStack.back();
+    auto before = std::optional<typename value_patch<T>::state>{};
+    if (edit_possible(leaf)) {
+        before = value_patch<T>::capture(value);
+    }
+
+    const leaf_watch watch;
+    recorder().in_leaf = true;
+    const bool changed = Renderer<config, T>::Render(name, value);
+    recorder().in_leaf = false;
+    watch.update(leaf);
+    count_activation();
+
+    // Commands sent to the owner of a value only need its new state, so they
+    // are sent even if nothing was snapshotted before the edit
+    if (changed && (before || recorder().edits)) {
+        auto data = std::make_unique<value_patch<T>>();
+        if (before) {
+            data->before = std::move(*before);
+        }
+        data->after = value_patch<T>::capture(value);
+        history_recorder::push(std::move(data), ImGui::GetActiveID());
+    }
+    return changed;
+}
+
+template <Config config, typename T>
+bool render(const char* name, T&& value)
+{
+    using Type = [:remove_cvref(^^T):];
+    IMREFL_PROFILE_SCOPE(name, std::define_static_string(display_string_of(^^Type)));
+    const std::size_t mark = change_mark();
+
+    if constexpr (constexpr auto sample = config.FetchAttn<SampleEvery>()) {
+        render_sampled(name, std::as_const(value), sample->milliseconds);
+        return false;
+    }
+
+    bool changed = false;
+    if constexpr (history_leaf<Type> && !std::is_const_v<std::remove_reference_t<T>>) {
+        changed = history_enabled()
+            ? render_recorded<config>(name, value)
+            : Renderer<config, Type>::Render(name, value);
+    } else {
+        changed = Renderer<config, Type>::Render(name, std::forward<T>(value));
+    }
+
+    if (changed) {
+        record_change(mark);
+    }
+    return changed;
+}
+
+// Equivalent to Input, but pushes an already computed ID rather than hashing
+// the name.
+template <Config config, typename T>
+bool input_with_id(ImGuiID id, const char* name, T&& value)
+{
+    ImGui::PushOverrideID(id);
+    const bool changed = render<config>(name, std::forward<T>(value));
+    ImGui::PopID();
+    return changed;
+}
+
+// Types whose Renderer always produces a single widget of frame height, so
+// their height is known without rendering them. T keeps its constness, as a
+// const std::string is drawn as text that may span several lines. Values shown
+// with sample_every are drawn as wrapped text, whatever their type.
+template <Config config, typename T>
+concept single_line =
+    !config.HasAttn<SampleEvery>() &&
+    (scalar<std::remove_cv_t<T>> ||
+     enumeration<std::remove_cv_t<T>> ||
+     std::same_as<std::remove_cv_t<T>, bool> ||
+     (std::same_as<T, std::string> && !config.HasAttn<Multiline>()));
+
+// The measured heights of aggregate members from the last time they were
+// rendered, keyed by the ID of the member. Zero means not measured yet.
+inline frame_cache<float>& member_heights()
+{
+    static frame_cache<float> heights;
+    return heights;
+}
+
+// If the member with the given ID is known to lie entirely outside the clip
+// rect, advances the cursor past it with a Dummy and returns true. Members
+// that have not been measured yet are never culled.
+inline bool cull_member(ImGuiID id, float known_height)
+{
+    const float height = known_height > 0.0f ? known_height : member_heights()[id];
+    if (height <= 0.0f || ImGui::IsRectVisible({1.0f, height})) {
+        return false;
+    }
+    ImGui::Dummy({0.0f, height - ImGui::GetStyle().ItemSpacing.y});
+    return true;
+}
+
+// CHANGE HIGHLIGHTING
+
+// Returns true if objects of the type can be compared with memcmp: scalars
+// other than long double, enums, and arrays and trivially copyable aggregates
+// of them without padding.
+consteval bool bitwise_comparable(std::meta::info type)
+{
+    type = remove_cv(type);
+    if (is_enum_type(type) || (is_arithmetic_type(type) && type != ^^long double)) {
+        return true;
+    }
+    if (is_array_type(type)) {
+        return bitwise_comparable(remove_extent(type));
+    }
+    if (!is_class_type(type) || !is_aggregate_type(type) || !is_trivially_copyable_type(type)) {
+        return false;
+    }
+
+    const auto ctx = std::meta::access_context::current();
+    if (!bases_of(type, ctx).empty()) {
+        return false;
+    }
+    std::size_t size = 0;
+    for (const auto member : nonstatic_data_members_of(type, ctx)) {
+        if (is_bit_field(member) || is_reference_type(type_of(member)) || !bitwise_comparable(type_of(member))) {
+            return false;
+        }
+        size += size_of(type_of(member));
+    }
+    return size == size_of(type);
+}
+
+// Contiguous ranges whose elements can be compared with memcmp as a whole. The
+// element type is only formed once the range checks are satisfied.
+template <typename R>
+concept bitwise_comparable_range =
+    std::ranges::contiguous_range<const R> &&
+    std::ranges::sized_range<const R> &&
+    bitwise_comparable(^^std::ranges::range_value_t<const R>);
+
+static_assert(bitwise_comparable_range<std::vector<int>>);
+static_assert(!bitwise_comparable_range<std::optional<int>>);
+
+// Compares two values member by member and element by element, using memcmp
+// for whatever is bitwise comparable. Values that cannot be compared are
+// treated as equal.
+template <typename T>
+bool values_equal(const T& lhs, const T& rhs)
+{
+    if constexpr (bitwise_comparable(^^T)) {
+        return std::memcmp(std::addressof(lhs), std::addressof(rhs), sizeof(T)) == 0;
+    }
+    else if constexpr (bitwise_comparable_range<T>) {
+        const auto size = std::ranges::size(lhs);
+        return size == std::ranges::size(rhs) &&
+               (size == 0 || std::memcmp(std::ranges::data(lhs), std::ranges::data(rhs), size * sizeof(*std::ranges::data(lhs))) == 0);
+    }
+    else if constexpr (std::ranges::forward_range<const T>) {
+        if constexpr (std::ranges::sized_range<const T>) {
+            if (std::ranges::size(lhs) != std::ranges::size(rhs)) {
+                return false;
+            }
+        }
+        return std::ranges::equal(lhs, rhs, [](const auto& a, const auto& b) { return values_equal(a, b); });
+    }
+    else if constexpr (aggregate<T>) {
+        bool equal = true;
+        template for (constexpr auto base : bases_of_type(^^T)) {
+            using Base = [:type_of(base):];
+            equal = equal && values_equal(static_cast<const Base&>(lhs), static_cast<const Base&>(rhs));
+        }
+        template for (constexpr auto member : nsdm_of(^^T)) {
+            equal = equal && values_equal(lhs.[:member:], rhs.[:member:]);
+        }
+        return equal;
+    }
+    else if constexpr (tuple_like<T>) {
+        bool equal = true;
+        template for (constexpr auto index : integer_sequence(tuple_size(^^T))) {
+            equal = equal && values_equal(std::get<index>(lhs), std::get<index>(rhs));
+        }
+        return equal;
+    }
+    else if constexpr (std::equality_comparable<T>) {
+        return lhs == rhs;
+    }
+    else {
+        return true;
+    }
+}
+
+struct highlight_shadow_base
+{
+    virtual ~highlight_shadow_base() = default;
+};
+
+template <typename T>
+struct highlight_shadow final : highlight_shadow_base
+{
+    T value;
+
+    explicit highlight_shadow(const T& v) : value(v) {}
+};
+
+// The value of a highlighted member as of the previous frame, and when it was
+// last seen to change.
+struct highlight_entry
+{
+    std::unique_ptr<highlight_shadow_base> shadow;
+    const void*                            tag        = nullptr;
+    int                                    last_seen  = 0;
+    double                                 changed_at = -DBL_MAX;
+};
+
+struct highlight_state
+{
+    std::unordered_map<ImGuiID, highlight_entry> entries;
+    int                                          frame = -1;
+};
+
+inline highlight_state& highlights()
+{
+    static highlight_state state;
+    return state;
+}
+
+// Compares the value of a member with its value from the previous frame and
+// draws a fading highlight over it, from start to the cursor, if it changed
+// recently. Shadows of members that were not drawn last frame, because they
+// were collapsed, culled or removed, are dropped.
+template <typename T>
+void draw_change_highlight(ImGuiID id, const T& value, ImVec2 start, float fade_seconds)
+{
+    if constexpr (std::copy_constructible<T>) {
+        auto& state = highlights();
+        const int frame = ImGui::GetFrameCount();
+        if (state.frame != frame) {
+            std::erase_if(state.entries, [&](const auto& entry) { return entry.second.last_seen < frame - 1; });
+            state.frame = frame;
+        }
+
+        auto& entry = state.entries[id];
+        const double now = ImGui::GetTime();
+        if (entry.tag != &type_tag<T>) {
+            entry.shadow = std::make_unique<highlight_shadow<T>>(value);
+            entry.tag = &type_tag<T>;
+            entry.changed_at = -DBL_MAX;
+        } else {
+            auto& shadow = static_cast<highlight_shadow<T>&>(*entry.shadow).value;
+            if (!values_equal(shadow, value)) {
+                if constexpr (std::is_copy_assignable_v<T>) {
+                    shadow = value;
+                } else {
+                    entry.shadow = std::make_unique<highlight_shadow<T>>(value);
+                }
+                entry.changed_at = now;
+            }
+        }
+        entry.last_seen = frame;
+
+        const float age = static_cast<float>(now - entry.changed_at);
+        if (age < fade_seconds) {
+            const ImVec2 end = {
+                ImGui::GetCursorScreenPos().x + ImGui::GetContentRegionAvail().x,
+                ImGui::GetCursorScreenPos().y - ImGui::GetStyle().ItemSpacing.y
+            };
+            const ImU32 color = ImGui::GetColorU32(ImGuiCol_TextSelectedBg, 1.0f - age / fade_seconds);
+            ImGui::GetWindowDrawList()->AddRectFilled(start, end, color);
+        }
+    }
+}
+
+// Returns the fade time of the highlight_changes annotation that applies to a
+// data member, either on the member itself or on its enclosing type, or zero.
+consteval float member_highlight(Config config, std::meta::info parent)
+{
+    if (const auto highlight = config.FetchAttn<HighlightChanges>()) {
+        return highlight->fade_seconds;
+    }
+    if (const auto highlight = fetch_type_attn<HighlightChanges>(parent)) {
+        return highlight->fade_seconds;
+    }
+    return 0.0f;
 }
 
-bool square_button(const char* name)
+// Renders a member of an aggregate under its compile-time hashed ID. Members
+// outside of the visible region are skipped using their last measured height,
+// so scrolling through a large expanded aggregate only costs what is on screen.
+// A positive highlight gives the fade time for highlighting changes.
+template <Config config, float highlight = 0.0f, typename T>
+bool render_member(std::size_t index, const static_id& id, const char* name, T&& value)
 {
-    const float button_size = ImGui::GetFrameHeight();
-    return ImGui::Button(name, {button_size, button_size});
+    using Value = std::remove_reference_t<T>;
+    const ImGuiID member_id = id.with_seed(ImGui::GetCurrentWindow()->IDStack.back());
+    const float known_height = single_line<config, Value> ? ImGui::GetFrameHeightWithSpacing() : 0.0f;
+    if (cull_member(member_id, known_height)) {
+        return false;
+    }
+
+    const path_scope scope{index};
+    const ImVec2 start_pos = ImGui::GetCursorScreenPos();
+    const float start = ImGui::GetCursorPosY();
+    // Nothing beneath input_with_id moves from the value, so it can still be
+    // read for highlighting after being forwarded
+    const bool changed = input_with_id<config>(member_id, name, std::forward<T>(value));
+    if constexpr (!single_line<config, Value>) {
+        member_heights()[member_id] = ImGui::GetCursorPosY() - start;
+    }
+    if constexpr (highlight > 0.0f) {
+        draw_change_highlight(member_id, std::as_const(value), start_pos, highlight);
+    }
+    return changed;
 }
 
-// Stores an object of type T in static storage and implements a popup
-// box for modifying the value. Returns a std::optional<T> containing the
-// produced value when the user clicks the Add button.
-template <Config config, std::default_initializable T>
-std::optional<T> get_new_value()
+// TABLE DRIVEN AGGREGATES
+
+template <typename T>
+concept table_driven_aggregate =
+    aggregate<T> &&
+    has_type_attn<TableDriven>(^^T);
+
+// The most regions that can be open at once within a table driven aggregate.
+inline constexpr std::size_t max_descriptor_regions = 16;
+
+enum field_flags : std::uint8_t
 {
-    static T value {};
-    if (square_button("+##get_new_value")) {
-        ImGui::OpenPopup("emplace_popup");
+    field_single_line       = 1 << 0,
+    field_end_region        = 1 << 1,
+    field_single_line_const = 1 << 2, // Single line when rendered read-only
+};
+
+// Describes how to render one data member of a table driven aggregate. The
+// renderers are shared by every member with the same type and annotations,
+// whichever aggregate it belongs to. Ignored members have no renderers and
+// readonly members have no mutable renderer.
+struct field_descriptor
+{
+    const char*      name;
+    std::size_t      offset;
+    const static_id* id;
+    const char*      separator;
+    const char*      begin_region;
+    std::size_t      end_region_levels;
+    std::uint8_t     flags;
+    bool (*render)(ImGuiID, const char*, void*);
+    bool (*render_const)(ImGuiID, const char*, const void*);
+    void (*on_change)(void*, void*);
+    float            highlight_fade;
+    void (*highlight)(ImGuiID, const void*, ImVec2, float);
+};
+
+template <Config config, typename T>
+bool render_erased(ImGuiID id, const char* name, void* value)
+{
+    return input_with_id<config>(id, name, *static_cast<T*>(value));
+}
+
+template <Config config, typename T>
+bool render_erased_const(ImGuiID id, const char* name, const void* value)
+{
+    return input_with_id<config>(id, name, *static_cast<const T*>(value));
+}
+
+template <auto fn, typename Parent, typename T>
+void on_change_erased(void* parent, void* value)
+{
+    std::invoke(fn, *static_cast<Parent*>(parent), *static_cast<T*>(value));
+}
+
+template <typename T>
+void highlight_erased(ImGuiID id, const void* value, ImVec2 start, float fade_seconds)
+{
+    draw_change_highlight(id, *static_cast<const T*>(value), start, fade_seconds);
+}
+
+template <aggregate T>
+inline constexpr auto field_descriptors = [] {
+    static_assert(max_region_depth(^^T) <= max_descriptor_regions, "Too many nested regions for a table driven aggregate");
+
+    std::array<field_descriptor, nsdm_of(^^T).size()> fields = {};
+    std::size_t index = 0;
+    template for (constexpr auto member : nsdm_of(^^T)) {
+        static_assert(!is_bit_field(member), "Table driven aggregates cannot contain bit-fields");
+        static_assert(!is_reference_type(type_of(member)), "Table driven aggregates cannot contain references");
+
+        constexpr auto config = member_config(^^T, member);
+        using Member = [:remove_cv(type_of(member)):];
+
+        auto& field = fields[index++];
+        field.name = identifier_of(member).data();
+        field.offset = offset_of(member).bytes;
+        field.id = &member_id<member>;
+
+        if constexpr (constexpr auto separator = config.FetchAttn<Separator>()) {
+            field.separator = separator->title;
+        }
+        if constexpr (constexpr auto br = config.FetchAttn<BeginRegion>()) {
+            field.begin_region = br->title;
+        }
+        if constexpr (constexpr auto er = config.FetchAttn<EndRegion>()) {
+            field.flags |= field_end_region;
+            field.end_region_levels = er->levels;
+        }
+
+        if constexpr (!config.HasAttn<Ignore>()) {
+            if constexpr (single_line<config, Member>) {
+                field.flags |= field_single_line;
+            }
+            if constexpr (single_line<config, const Member>) {
+                field.flags |= field_single_line_const;
+            }
+            if constexpr (!config.HasAttn<Readonly>() && !is_const_type(type_of(member))) {
+                field.render = &render_erased<config, Member>;
+                if constexpr (constexpr auto on_change = config.FetchAttnOfTemplate(^^OnChange)) {
+                    field.on_change = &on_change_erased<[:*on_change:].fn, T, Member>;
+                }
+            }
+            field.render_const = &render_erased_const<config, Member>;
+            if constexpr (constexpr float fade = member_highlight(config, ^^T); fade > 0.0f) {
+                field.highlight_fade = fade;
+                field.highlight = &highlight_erased<Member>;
+            }
+        }
     }
+    return fields;
+}();
 
-    auto return_val = std::optional<T>{};
-    if (ImGui::BeginPopup("emplace_popup")) {
-        Input<config>("[new key]", value);
-        if (ImGui::Button("Add")) {
-            ImGui::CloseCurrentPopup();
-            return_val = value;        
-            value = {};
+// Renders the members of an aggregate from its field descriptors. This is the
+// same for every table driven aggregate, so it is compiled once rather than
+// unrolled for each type. The object is only written to if writable is true.
+inline bool render_descriptors(std::span<const field_descriptor> fields, const void* object, bool writable)
+{
+    const auto* base = static_cast<const std::byte*>(object);
+    const ImGuiID seed = ImGui::GetCurrentWindow()->IDStack.back();
+
+    bool changed = false;
+    region_stack<max_descriptor_regions> regions;
+    for (const auto& field : fields) {
+        if (field.flags & field_end_region) {
+            regions.end(field.end_region_levels);
+        }
+        if (field.begin_region) {
+            regions.begin(field.begin_region);
+        }
+
+        if (!field.render_const || !regions.visible()) {
+            continue;
+        }
+        if (field.separator) {
+            ImGui::SeparatorText(field.separator);
+        }
+
+        const ImGuiID id = field.id->with_seed(seed);
+        const bool writes = writable && field.render;
+        const bool single = field.flags & (writes ? field_single_line : field_single_line_const);
+        if (cull_member(id, single ? ImGui::GetFrameHeightWithSpacing() : 0.0f)) {
+            continue;
+        }
+
+        const path_scope scope{static_cast<std::size_t>(&field - fields.data())};
+        const ImVec2 start_pos = ImGui::GetCursorScreenPos();
+        const float start = ImGui::GetCursorPosY();
+        const void* value = base + field.offset;
+        if (writes) {
+            if (field.render(id, field.name, const_cast<void*>(value))) {
+                if (field.on_change) {
+                    field.on_change(const_cast<void*>(object), const_cast<void*>(value));
+                }
+                changed = true;
+            }
+        } else {
+            field.render_const(id, field.name, value);
+        }
+        if (!single) {
+            member_heights()[id] = ImGui::GetCursorPosY() - start;
+        }
+        if (field.highlight) {
+            field.highlight(id, value, start_pos, field.highlight_fade);
         }
-        ImGui::EndPopup();
     }
-    return return_val;
+
+    regions.end_all();
+    return changed;
 }
 
 // Helper wrapper for std::format_to_n for small strings. Should be used carefully
@@ -391,60 +2627,529 @@ small_string fmt(std::format_string<Args...> fmt, Args&&... args)
     return ret;
 }
 
-// INTERNAL RENDERER IMPLEMENTATIONS
+// Builds labels such as "[12]" or "##12" for the elements of containers. This
+// is called for every visible element every frame, so it writes the digits
+// directly rather than going through std::format.
+inline small_string index_label(std::string_view prefix, std::size_t index, std::string_view suffix = {})
+{
+    small_string ret;
+    char* out = std::ranges::copy(prefix, ret.buf).out;
+    out = std::to_chars(out, std::end(ret.buf) - suffix.size() - 1, index).ptr;
+    out = std::ranges::copy(suffix, out).out;
+    *out = '\0';
+    return ret;
+}
+
+// INTERNAL RENDERER IMPLEMENTATIONS
+
+template <Config config, typename T>
+bool render_pointer_as_value(const char* name, T* value)
+{
+    if (value) {
+        return Input<config>(name, *value);
+    } else {
+        ImGui::Text("%s: <nullptr>", name);
+        return false;
+    }
+}
+
+template <Config config, std::ranges::forward_range R>
+bool render_range_element(const char* name, std::size_t i, R& range, std::ranges::iterator_t<R>& it)
+{
+    const auto index_name = index_label("[", i, "]");
+    auto&& element = *it;
+
+    bool changed = false;
+    if constexpr (detail::is_swappable<R>) {
+        {
+            const path_scope scope{i};
+            changed = Input<config>(index_label("##", i), element);
+        }
+
+        ImGui::SameLine();
+        const float selectableWidth = ImGui::CalcTextSize(index_name).x;
+        ImGui::Selectable(index_name, false, ImGuiSelectableFlags_None, {selectableWidth, 0});
+        if (ImGui::BeginDragDropSource()) {
+            ImGui::SetDragDropPayload(name, &i, sizeof(std::size_t));
+            ImGui::EndDragDropSource();
+        }
+        if (ImGui::BeginDragDropTarget()) {
+            if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload(name)) {
+                const std::size_t index = *(const std::size_t*)payload->Data;
+                if (index != i) {
+                    std::swap(range[index], element);
+                    record_swap(range, index, i);
+                    record_current_change();
+                    changed = true;
+                }
+            }
+            ImGui::EndDragDropTarget();
+        }
+    }
+    else {
+        const path_scope scope{i};
+        changed = Input<config>(index_name, element);
+    }
+
+    if constexpr (can_erase<R> && !config.HasAttn<NonResizable>()) {
+        ImGui::SameLine();
+        if (square_button(index_label("-##e", i))) {
+            record_range_op<range_op::erase>(range, i, *it);
+            it = range.erase(it);
+            record_current_change();
+            changed = true;
+        } else {
+            ++it;
+        }
+    }
+    else {
+        ++it;
+    }
+
+    return changed;
+}
+
+// Returns the minimum and maximum of the given samples as floats. Eight
+// independent accumulators are kept so that the loop vectorizes without
+// needing to relax floating point semantics. The samples must be non-empty.
+template <scalar T>
+std::pair<float, float> minmax_samples(std::span<const T> samples)
+{
+    constexpr std::size_t lanes = 8;
+    float lo[lanes];
+    float hi[lanes];
+    std::ranges::fill(lo, static_cast<float>(samples[0]));
+    std::ranges::fill(hi, static_cast<float>(samples[0]));
+
+    std::size_t i = 0;
+    for (; i + lanes <= samples.size(); i += lanes) {
+        for (std::size_t lane = 0; lane != lanes; ++lane) {
+            const float value = static_cast<float>(samples[i + lane]);
+            lo[lane] = value < lo[lane] ? value : lo[lane];
+            hi[lane] = value > hi[lane] ? value : hi[lane];
+        }
+    }
+    for (; i != samples.size(); ++i) {
+        const float value = static_cast<float>(samples[i]);
+        lo[0] = value < lo[0] ? value : lo[0];
+        hi[0] = value > hi[0] ? value : hi[0];
+    }
+
+    return {*std::ranges::min_element(lo), *std::ranges::max_element(hi)};
+}
+
+// Reduces the samples to at most one min/max pair (or just the max, for
+// histograms) per pixel column so that ImGui only ever sees a few hundred
+// values and no peaks are lost to its own per-pixel sampling. The returned
+// span points into a grow-only buffer that is reused between calls.
+template <scalar T>
+std::span<const float> downsample(std::span<const T> samples, std::size_t columns, bool histogram)
+{
+    const std::size_t per_column = histogram ? 1 : 2;
+    if constexpr (^^T == ^^float) {
+        if (samples.size() <= columns * per_column) {
+            return samples;
+        }
+    }
+
+    static std::vector<float> buffer;
+    buffer.clear();
+
+    if (samples.size() <= columns * per_column) {
+        for (const T sample : samples) {
+            buffer.push_back(static_cast<float>(sample));
+        }
+        return buffer;
+    }
+
+    for (std::size_t column = 0; column != columns; ++column) {
+        const std::size_t first = column * samples.size() / columns;
+        const std::size_t last = (column + 1) * samples.size() / columns;
+        const auto [lo, hi] = minmax_samples(samples.subspan(first, last - first));
+        if (!histogram) {
+            buffer.push_back(lo);
+        }
+        buffer.push_back(hi);
+    }
+    return buffer;
+}
+
+template <Config config, scalar T>
+void render_plot(const char* name, std::span<const T> samples)
+{
+    constexpr auto style = config.FetchAttn<Plot>();
+    const auto columns = static_cast<std::size_t>(std::max(1.0f, ImGui::CalcItemWidth()));
+    const auto values = downsample(samples, columns, style->histogram);
+    const int count = static_cast<int>(values.size());
+    const ImVec2 size = {0.0f, style->height};
+
+    if constexpr (style->histogram) {
+        ImGui::PlotHistogram(name, values.data(), count, 0, nullptr, FLT_MAX, FLT_MAX, size);
+    } else {
+        ImGui::PlotLines(name, values.data(), count, 0, nullptr, FLT_MAX, FLT_MAX, size);
+    }
+}
+
+// Renders a byte buffer as a hex dump of 16 bytes per row, with the offset on
+// the left and the printable ASCII characters on the right. Rows are clipped to
+// the visible region, and each byte is editable unless the buffer is const.
+template <byte_like Byte>
+bool render_hex_view(std::span<Byte> bytes)
+{
+    constexpr std::size_t row_size = 16;
+    constexpr const char* digits = "0123456789ABCDEF";
+    const ImGuiStyle& style = ImGui::GetStyle();
+    const float byte_width = ImGui::CalcTextSize("FF").x + style.FramePadding.x * 2;
+    const float offset_width = ImGui::CalcTextSize("00000000").x + style.ItemSpacing.x;
+    const float ascii_offset = offset_width + row_size * (byte_width + style.ItemInnerSpacing.x) + style.ItemSpacing.x;
+
+    bool changed = false;
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>((bytes.size() + row_size - 1) / row_size));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            const std::size_t offset = static_cast<std::size_t>(row) * row_size;
+            const auto line = bytes.subspan(offset, std::min(row_size, bytes.size() - offset));
+
+            char ascii[row_size];
+            for (std::size_t i = 0; i != line.size(); ++i) {
+                const auto c = static_cast<unsigned char>(line[i]);
+                ascii[i] = (c >= 0x20 && c < 0x7F) ? static_cast<char>(c) : '.';
+            }
+
+            if constexpr (std::is_const_v<Byte>) {
+                // Build the whole row up front so that it is a single text item.
+                // The offset is printed in full so that it does not wrap at 4 GiB
+                constexpr int offset_digits = 2 * sizeof(std::size_t);
+                char text[offset_digits + 3 * row_size + 2];
+                char* out = text;
+                for (int shift = offset_digits * 4 - 4; shift >= 0; shift -= 4) {
+                    *out++ = digits[(offset >> shift) & 0xF];
+                }
+                for (const auto byte : line) {
+                    const auto c = static_cast<unsigned char>(byte);
+                    *out++ = ' ';
+                    *out++ = digits[c >> 4];
+                    *out++ = digits[c & 0xF];
+                }
+                ImGui::TextUnformatted(text, out);
+                ImGui::SameLine();
+                ImGui::TextUnformatted(ascii, ascii + line.size());
+            } else {
+                const float line_start = ImGui::GetCursorPosX();
+                ImGui::PushID(row);
+                ImGui::AlignTextToFramePadding();
+                ImGui::Text("%08zX", offset);
+                for (std::size_t i = 0; i != line.size(); ++i) {
+                    ImGui::SameLine(line_start + offset_width + i * (byte_width + style.ItemInnerSpacing.x));
+                    auto value = static_cast<std::uint8_t>(line[i]);
+                    ImGui::PushID(static_cast<int>(i));
+                    ImGui::SetNextItemWidth(byte_width);
+                    if (ImGui::InputScalar("##byte", ImGuiDataType_U8, &value, nullptr, nullptr, "%02X", ImGuiInputTextFlags_CharsHexadecimal)) {
+                        const path_scope scope{offset + i};
+                        record_value_change(line[i], static_cast<Byte>(value), ImGui::GetActiveID());
+                        line[i] = static_cast<Byte>(value);
+                        record_change(change_mark());
+                        changed = true;
+                    }
+                    ImGui::PopID();
+                }
+                ImGui::SameLine(line_start + ascii_offset);
+                ImGui::TextUnformatted(ascii, ascii + line.size());
+                ImGui::PopID();
+            }
+        }
+    }
+    return changed;
+}
+
+// Returns the members of an aggregate that are shown as columns when a range
+// of them is rendered as a table.
+consteval auto table_columns(std::meta::info type)
+{
+    std::vector<std::meta::info> columns;
+    for (const auto member : nsdm_of(type)) {
+        if (!member_config(type, member).HasAttn<Ignore>()) {
+            columns.push_back(member);
+        }
+    }
+    return std::define_static_array(columns);
+}
+
+// Compares a single column of two table rows, returning a negative value, zero
+// or a positive value in the style of strcmp.
+template <aggregate T>
+int compare_table_column(const T& lhs, const T& rhs, std::size_t column)
+{
+    int result = 0;
+    template for (constexpr auto index : integer_sequence(table_columns(^^T).size())) {
+        constexpr auto member = table_columns(^^T)[index];
+        using Member = [:type_of(member):];
+        if constexpr (std::totally_ordered<Member>) {
+            if (index == column) {
+                const auto& l = lhs.[:member:];
+                const auto& r = rhs.[:member:];
+                result = (l < r) ? -1 : (r < l) ? 1 : 0;
+            }
+        }
+    }
+    return result;
+}
+
+// Returns the order in which the rows of the current table should be shown.
+// This is a permutation of the row indices rather than a sort of the range
+// itself, and is only recomputed when the sort specs or the row count change.
+template <table_range R>
+const std::vector<std::size_t>& table_row_order(R& range)
+{
+    static frame_cache<std::vector<std::size_t>> orders;
+    auto& order = orders[ImGui::GetID("##order")];
+
+    ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs();
+    const auto size = static_cast<std::size_t>(std::ranges::size(range));
+    if (order.size() != size || (specs && specs->SpecsDirty)) {
+        order.resize(size);
+        std::iota(order.begin(), order.end(), 0);
+
+        if (specs && specs->SpecsCount > 0) {
+            const auto rows = std::ranges::begin(range);
+            std::ranges::stable_sort(order, [&](std::size_t a, std::size_t b) {
+                for (int i = 0; i != specs->SpecsCount; ++i) {
+                    const ImGuiTableColumnSortSpecs& spec = specs->Specs[i];
+                    const int cmp = spec.ColumnUserID == 0
+                        ? (a < b ? -1 : (b < a ? 1 : 0))
+                        : compare_table_column(rows[a], rows[b], spec.ColumnUserID - 1);
+                    if (cmp != 0) {
+                        return spec.SortDirection == ImGuiSortDirection_Ascending ? cmp < 0 : cmp > 0;
+                    }
+                }
+                return false;
+            });
+        }
+
+        if (specs) {
+            specs->SpecsDirty = false;
+        }
+    }
+    return order;
+}
+
+// Renders a range of aggregates as a table with one column per member. Rows are
+// clipped to the visible region of the table, and columns of totally ordered
+// types can be sorted by clicking on their headers.
+template <Config config, table_range R>
+bool render_table_elements(R& range)
+{
+    using Element = std::ranges::range_value_t<R>;
+    constexpr auto columns = table_columns(^^Element);
+    constexpr bool is_const = std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<R>>>;
+
+    const int flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable |
+                      ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti | ImGuiTableFlags_ScrollY;
+    const auto visible_rows = std::min<std::size_t>(std::ranges::size(range), 20);
+    const ImVec2 outer_size = {0.0f, ImGui::GetFrameHeightWithSpacing() * (visible_rows + 1)};
+    if (!ImGui::BeginTable("##table", static_cast<int>(columns.size()) + 1, flags, outer_size)) {
+        return false;
+    }
+
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("#", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort, 0.0f, 0);
+    template for (constexpr auto index : integer_sequence(columns.size())) {
+        constexpr auto member = columns[index];
+        using Member = [:type_of(member):];
+        const int column_flags = std::totally_ordered<Member> ? ImGuiTableColumnFlags_None : ImGuiTableColumnFlags_NoSort;
+        ImGui::TableSetupColumn(identifier_of(member).data(), column_flags, 0.0f, static_cast<ImGuiID>(index + 1));
+    }
+    ImGui::TableHeadersRow();
+
+    const auto& order = table_row_order(range);
+
+    bool changed = false;
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(order.size()));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            const std::size_t i = order[row];
+            auto&& element = std::ranges::begin(range)[i];
+
+            ImGui::TableNextRow();
+            const path_scope row_scope{i};
+            ImGui::PushID(static_cast<int>(i));
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", i);
+
+            template for (constexpr auto index : integer_sequence(columns.size())) {
+                constexpr auto member = columns[index];
+                constexpr auto cell_config = member_config(^^Element, member);
+
+                ImGui::TableNextColumn();
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                ImGui::PushID(static_cast<int>(index));
+                const path_scope cell_scope{MemberIndex(member)};
+                if constexpr (is_const || cell_config.HasAttn<Readonly>()) {
+                    Input<cell_config>("##cell", std::as_const(element.[:member:]));
+                } else {
+                    const bool cell_changed = Input<cell_config>("##cell", element.[:member:]);
+                    if constexpr (constexpr auto on_change = cell_config.FetchAttnOfTemplate(^^OnChange)) {
+                        if (cell_changed) {
+                            std::invoke([:*on_change:].fn, element, element.[:member:]);
+                        }
+                    }
+                    changed = cell_changed || changed;
+                }
+                ImGui::PopID();
+            }
+
+            ImGui::PopID();
+        }
+    }
+
+    ImGui::EndTable();
+    return changed;
+}
+
+// Caches an iterator to every stride-th element of a node-based range so that
+// reaching element i only walks from the nearest checkpoint rather than from
+// the beginning. Checkpoints are added lazily and the whole cache is dropped
+// when the size or address of the range changes.
+//
+// The cache is only valid for ranges whose elements are added and removed
+// through ImRefl, which bumps structure_generation(). Iterators cannot be
+// checked for validity, so a range that has elements erased and inserted
+// elsewhere while keeping its size would leave dangling checkpoints unless
+// InvalidateCaches() is called.
+template <std::ranges::forward_range R>
+struct checkpoint_cache
+{
+    using iterator = std::ranges::iterator_t<R>;
+
+    const void*           owner      = nullptr;
+    std::size_t           size       = 0;
+    std::uint64_t         generation = 0;
+    std::vector<iterator> checkpoints;
+
+    iterator seek(R& range, std::size_t index, std::size_t stride)
+    {
+        const auto current_size = static_cast<std::size_t>(std::ranges::size(range));
+        if (owner != &range || size != current_size || generation != structure_generation()) {
+            owner = &range;
+            size = current_size;
+            generation = structure_generation();
+            checkpoints.clear();
+        }
+
+        if (checkpoints.empty()) {
+            checkpoints.push_back(std::ranges::begin(range));
+        }
+        const std::size_t checkpoint = index / stride;
+        while (checkpoints.size() <= checkpoint) {
+            checkpoints.push_back(std::ranges::next(checkpoints.back(), stride));
+        }
+        return std::ranges::next(checkpoints[checkpoint], index % stride);
+    }
+};
+
+// Returns an iterator to the element at the given index, using a per-widget
+// checkpoint_cache for sized ranges that cannot be indexed directly. Caches of
+// widgets that were not drawn in the previous frame are dropped.
+template <std::ranges::forward_range R>
+std::ranges::iterator_t<R> seek_range(R& range, std::size_t index, std::size_t stride)
+{
+    if constexpr (std::ranges::random_access_range<R>) {
+        return std::ranges::begin(range) + index;
+    }
+    else if constexpr (std::ranges::sized_range<R>) {
+        static frame_cache<checkpoint_cache<R>> caches;
+        return caches[ImGui::GetID("##checkpoints")].seek(range, index, stride);
+    }
+    else {
+        return std::ranges::next(std::ranges::begin(range), index);
+    }
+}
+
+// Draws the page selector for a paged range and returns the [first, last)
+// indices of the elements on the current page. The page index and size are
+// kept in the ImGui state storage so that they persist between frames.
+inline std::pair<std::size_t, std::size_t> render_page_controls(std::size_t size, int default_page_size)
+{
+    ImGuiStorage* storage = ImGui::GetStateStorage();
+    const ImGuiID page_id = ImGui::GetID("##page");
+    const ImGuiID page_size_id = ImGui::GetID("##page_size");
+    const ImGuiStyle& style = ImGui::GetStyle();
+
+    int page_size = std::max(1, storage->GetInt(page_size_id, default_page_size));
+    const auto num_pages = static_cast<int>(std::max<std::size_t>(1, (size + page_size - 1) / page_size));
+    int page = std::clamp(storage->GetInt(page_id, 0), 0, num_pages - 1);
+
+    if (square_button("<##page") && page > 0) {
+        --page;
+    }
+    ImGui::SameLine(0, style.ItemInnerSpacing.x);
+    if (square_button(">##page") && page < num_pages - 1) {
+        ++page;
+    }
 
-template <Config config, typename T>
-bool render_pointer_as_value(const char* name, T* value)
-{
-    if (value) {
-        return Input<config>(name, *value);
-    } else {
-        ImGui::Text("%s: <nullptr>", name);
-        return false;
+    const float num_width = ImGui::CalcTextSize("0000000000000000").x;
+    ImGui::SameLine(0, style.ItemInnerSpacing.x);
+    ImGui::SetNextItemWidth(num_width);
+    int page_number = page + 1;
+    if (ImGui::DragInt("##page_number", &page_number, 1.0f, 1, num_pages, "page %d")) {
+        page = std::clamp(page_number, 1, num_pages) - 1;
+    }
+    ImGui::SameLine(0, style.ItemInnerSpacing.x);
+    ImGui::Text("of %d", num_pages);
+
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(num_width);
+    if (ImGui::DragInt("##page_size", &page_size, 1.0f, 1, INT_MAX, "%d per page")) {
+        page_size = std::max(1, page_size);
     }
+
+    storage->SetInt(page_id, page);
+    storage->SetInt(page_size_id, page_size);
+
+    const std::size_t first = static_cast<std::size_t>(page) * page_size;
+    return {first, std::min(size, first + page_size)};
 }
 
+// Renders a single page of the range. Combined with seek_range this makes the
+// cost of viewing any page O(stride + page size) for node-based containers.
 template <Config config, std::ranges::forward_range R>
-bool render_range_element(const char* name, std::size_t i, R& range, std::ranges::iterator_t<R>& it)
+bool render_paged_elements(const char* name, R& range)
 {
-    const auto index_name = fmt("[{}]", i);
-    auto&& element = *it;
+    constexpr auto paged = config.FetchAttn<Paged>();
+    static_assert(paged->checkpoint_stride > 0, "the checkpoint stride of a paged range must be positive");
+    const auto size = static_cast<std::size_t>(std::ranges::distance(range));
+    const auto [first, last] = render_page_controls(size, paged->page_size);
 
     bool changed = false;
-    if constexpr (detail::is_swappable<R>) {
-        changed = Input<config>(fmt("##{}", i), element);
-
-        ImGui::SameLine();
-        const float selectableWidth = ImGui::CalcTextSize(index_name).x;
-        ImGui::Selectable(index_name, false, ImGuiSelectableFlags_None, {selectableWidth, 0});
-        if (ImGui::BeginDragDropSource()) {
-            ImGui::SetDragDropPayload(name, &i, sizeof(std::size_t));
-            ImGui::EndDragDropSource();
-        }
-        if (ImGui::BeginDragDropTarget()) {
-            if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload(name)) {
-                const std::size_t index = *(const std::size_t*)payload->Data;
-                if (index != i) std::swap(range[index], element);
-            }
-            ImGui::EndDragDropTarget();
-        }
-    }
-    else {
-        changed = Input<config>(index_name, element);
+    auto it = seek_range(range, first, paged->checkpoint_stride);
+    for (std::size_t i = first; i != last && it != std::ranges::end(range); ++i) {
+        changed |= render_range_element<config>(name, i, range, it);
     }
+    return changed;
+}
 
-    if constexpr (can_erase<R> && !config.HasAttn<NonResizable>()) {
-        ImGui::SameLine();
-        if (square_button(fmt("-##e{}", i))) {
-            it = range.erase(it);
-        } else {
-            ++it;
+// Renders only the elements that fall within the visible scroll region, making
+// the cost proportional to the number of visible rows rather than the size of
+// the range. ImGuiListClipper assumes every row has the same height, so this is
+// only used when requested via the clipped annotation.
+template <Config config, clippable R>
+bool render_clipped_elements(const char* name, R& range)
+{
+    bool changed = false;
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(std::ranges::size(range)));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            // An erase earlier in this pass may have shortened the range
+            if (row >= static_cast<int>(std::ranges::size(range))) {
+                break;
+            }
+            auto it = std::ranges::begin(range) + row;
+            changed |= render_range_element<config>(name, static_cast<std::size_t>(row), range, it);
         }
     }
-    else {
-        ++it;
-    }
-
     return changed;
 }
 
@@ -453,14 +3158,19 @@ bool render_push_pop_front(R& range)
 {
     bool changed = false;
     if (square_button("-##front") && !std::ranges::empty(range)) {
+        record_range_op<range_op::pop_front>(range, 0, range.front());
         range.pop_front();
         changed = true;
     }
     ImGui::SameLine(0, ImGui::GetStyle().ItemInnerSpacing.x);
     if (square_button("+##front")) {
         range.emplace_front();
+        record_range_op<range_op::push_front>(range, 0);
         changed = true;
     }
+    if (changed) {
+        record_current_change();
+    }
     return changed;
 }
 
@@ -475,20 +3185,24 @@ bool render_push_pop_back(R& range)
     
     bool changed = false;
     if (square_button("-##back") && !std::ranges::empty(range)) {
+        record_range_op<range_op::pop_back>(range, 0, range.back());
         range.pop_back();
+        record_current_change();
         changed = true;
     }
 
     // If we are at the max size, don't allow pushing a new element
     if constexpr (detail::has_max_size<R>) {
         if (range.size() == R::max_size()) {
-            return false;
+            return changed;
         }
     }
 
     ImGui::SameLine(0, ImGui::GetStyle().ItemInnerSpacing.x);
     if (square_button("+##back")) {
         range.emplace_back();
+        record_range_op<range_op::push_back>(range, 0);
+        record_current_change();
         changed = true;
     }
     return changed;
@@ -497,6 +3211,12 @@ bool render_push_pop_back(R& range)
 template <Config config, std::ranges::forward_range R>
 bool render_forward_range(const char* name, R& range)
 {
+    if constexpr (config.HasAttn<Plot>() && plottable<R>) {
+        using Sample = std::ranges::range_value_t<R>;
+        render_plot<config>(name, std::span<const Sample>{std::ranges::data(range), std::ranges::size(range)});
+        return false;
+    }
+
     if (!TreeNodeExNoDisable(name)) {
         return false;
     }
@@ -507,10 +3227,20 @@ bool render_forward_range(const char* name, R& range)
         changed |= render_push_pop_front(range);
     }
 
-    std::size_t i = 0;
-    for (auto it = range.begin(); it != range.end();) {
-        changed |= render_range_element<config>(name, i, range, it);
-        ++i;
+    if constexpr (config.HasAttn<Hex>() && byte_range<R>) {
+        changed |= render_hex_view(std::span{std::ranges::data(range), std::ranges::size(range)});
+    } else if constexpr (config.HasAttn<Table>() && table_range<R>) {
+        changed |= render_table_elements<config>(range);
+    } else if constexpr (config.HasAttn<Paged>()) {
+        changed |= render_paged_elements<config>(name, range);
+    } else if constexpr (config.HasAttn<Clipped>() && clippable<R>) {
+        changed |= render_clipped_elements<config>(name, range);
+    } else {
+        std::size_t i = 0;
+        for (auto it = range.begin(); it != range.end();) {
+            changed |= render_range_element<config>(name, i, range, it);
+            ++i;
+        }
     }
 
     if constexpr (!config.HasAttn<NonResizable>() && can_push_pop_back<R>) {
@@ -522,7 +3252,12 @@ bool render_forward_range(const char* name, R& range)
             using Key = typename R::key_type;
             using Value = typename R::mapped_type;
             if (auto new_val = get_new_value<config, Key>()) {
+                const auto old_size = std::ranges::size(range);
                 range.emplace(*new_val, Value{});
+                if (std::ranges::size(range) != old_size) {
+                    record_range_op<range_op::emplace>(range, 0, std::ranges::range_value_t<R>{*new_val, Value{}});
+                }
+                record_current_change();
                 changed = true; // not necessarily true if the key already exists
             }
         }
@@ -530,7 +3265,12 @@ bool render_forward_range(const char* name, R& range)
         else if constexpr (is_set_type<R>) {
             using Key = typename R::key_type;
             if (auto new_val = get_new_value<config, Key>()) {
+                const auto old_size = std::ranges::size(range);
                 range.emplace(*new_val);
+                if (std::ranges::size(range) != old_size) {
+                    record_range_op<range_op::emplace>(range, 0, *new_val);
+                }
+                record_current_change();
                 changed = true; // not necessarily true if the key already exists
             }
         }
@@ -543,11 +3283,39 @@ bool render_forward_range(const char* name, R& range)
 template <Config config, std::ranges::forward_range R>
 bool render_forward_range(const char* name, const R& range)
 {
+    if constexpr (config.HasAttn<Plot>() && plottable<const R>) {
+        using Sample = std::ranges::range_value_t<R>;
+        render_plot<config>(name, std::span<const Sample>{std::ranges::data(range), std::ranges::size(range)});
+        return false;
+    }
+
     if (TreeNodeExNoDisable(name)) {
-        std::size_t i = 0;
-        for (auto&& element : range) {
-            Input<config>(fmt("[{}]", i), element); 
-            ++i;
+        if constexpr (config.HasAttn<Hex>() && byte_range<const R>) {
+            render_hex_view(std::span{std::ranges::data(range), std::ranges::size(range)});
+        } else if constexpr (config.HasAttn<Table>() && table_range<const R>) {
+            render_table_elements<config>(range);
+        } else if constexpr (constexpr auto paged = config.FetchAttn<Paged>()) {
+            static_assert(paged->checkpoint_stride > 0, "the checkpoint stride of a paged range must be positive");
+            const auto size = static_cast<std::size_t>(std::ranges::distance(range));
+            const auto [first, last] = render_page_controls(size, paged->page_size);
+            auto it = seek_range(range, first, paged->checkpoint_stride);
+            for (std::size_t i = first; i != last; ++i, ++it) {
+                Input<config>(index_label("[", i, "]"), *it);
+            }
+        } else if constexpr (config.HasAttn<Clipped>() && clippable<const R>) {
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(std::ranges::size(range)));
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                    Input<config>(index_label("[", row, "]"), std::ranges::begin(range)[row]);
+                }
+            }
+        } else {
+            std::size_t i = 0;
+            for (auto&& element : range) {
+                Input<config>(index_label("[", i, "]"), element); 
+                ++i;
+            }
         }
         ImGui::TreePop();
     }
@@ -582,7 +3350,7 @@ bool render_scalar_n(const char* name, const T* val, std::size_t count)
     ImGui::BeginGroup();
     ImGui::PushMultiItemsWidths(count, ImGui::CalcItemWidth());
     for (std::size_t i = 0; i != count; ++i) {
-        Input<config>(fmt("##{}", i), val[i]);
+        Input<config>(index_label("##", i), val[i]);
         ImGui::PopItemWidth();
         ImGui::SameLine(0, ImGui::GetStyle().ItemInnerSpacing.x);
     }
@@ -597,7 +3365,8 @@ bool render_tuple_like(const char* name, T& value)
     bool changed = false;
     ImGui::Text("%s", name);
     template for (constexpr auto index : integer_sequence(tuple_size(^^T))) {
-        changed = Input<config>(fmt("##{}", index), std::get<index>(value)) || changed;
+        const path_scope scope{index};
+        changed = Input<config>(index_label("##", index), std::get<index>(value)) || changed;
     }
     return changed;
 }
@@ -607,13 +3376,120 @@ bool render_tuple_like(const char* name, const T& value)
 {
     ImGui::Text("%s", name);
     template for (constexpr auto index : integer_sequence(tuple_size(^^T))) {
-        Input<config>(fmt("##{}", index), std::get<index>(value));
+        Input<config>(index_label("##", index), std::get<index>(value));
     }
     return false;
 }
 
+inline int string_resize_callback(ImGuiInputTextCallbackData* data)
+{
+    if (data->EventFlag == ImGuiInputTextFlags_CallbackResize) {
+        auto* str = static_cast<std::string*>(data->UserData);
+        str->resize(data->BufTextLen);
+        data->Buf = str->data();
+    }
+    return 0;
+}
+
+// The offsets of the start of each line of a string. This is only rebuilt
+// when the data pointer or size of the string changes, or when invalidated
+// after an edit.
+struct line_index
+{
+    const char*              data = nullptr;
+    std::size_t              size = 0;
+    std::vector<std::size_t> starts;
+
+    void update(std::string_view text)
+    {
+        if (text.data() == data && text.size() == size && !starts.empty()) {
+            return;
+        }
+        data = text.data();
+        size = text.size();
+        starts.assign(1, 0);
+        for (auto pos = text.find('\n'); pos != std::string_view::npos; pos = text.find('\n', pos + 1)) {
+            starts.push_back(pos + 1);
+        }
+    }
+
+    void invalidate() { starts.clear(); }
+
+    std::string_view line(std::string_view text, std::size_t i) const
+    {
+        const std::size_t end = (i + 1 < starts.size()) ? starts[i + 1] - 1 : text.size();
+        return text.substr(starts[i], end - starts[i]);
+    }
+};
+
+inline line_index& line_index_for(ImGuiID id)
+{
+    static frame_cache<line_index> indices;
+    return indices[id];
+}
+
+// Renders a large block of text in a scrolling child window, only laying out
+// the lines within the visible region.
+inline void render_text_viewer(std::string_view text, int visible_lines)
+{
+    auto& index = line_index_for(ImGui::GetID("##lines"));
+    index.update(text);
+
+    const ImGuiStyle& style = ImGui::GetStyle();
+    const ImVec2 size = {0.0f, ImGui::GetTextLineHeightWithSpacing() * visible_lines + style.WindowPadding.y * 2};
+    if (ImGui::BeginChild("##viewer", size, ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar)) {
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(index.starts.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const auto line = index.line(text, row);
+                ImGui::TextUnformatted(line.data(), line.data() + line.size());
+            }
+        }
+    }
+    ImGui::EndChild();
+}
+
+// Renders a string as a clipped multiline viewer, switching to a full
+// multiline text editor only while the user is editing it. The editing state
+// is kept in the ImGui state storage.
+inline bool render_multiline_string(const char* name, std::string& value, int visible_lines)
+{
+    ImGuiStorage* storage = ImGui::GetStateStorage();
+    const ImGuiID editing_id = ImGui::GetID("##editing");
+    bool editing = storage->GetBool(editing_id, false);
+
+    ImGui::Text("%s", name);
+    ImGui::SameLine();
+    if (ImGui::SmallButton(editing ? "Done" : "Edit")) {
+        editing = !editing;
+        storage->SetBool(editing_id, editing);
+    }
+
+    if (!editing) {
+        render_text_viewer(value, visible_lines);
+        return false;
+    }
+
+    const ImGuiStyle& style = ImGui::GetStyle();
+    const ImVec2 size = {-FLT_MIN, ImGui::GetTextLineHeight() * visible_lines + style.FramePadding.y * 2};
+    const bool changed = ImGui::InputTextMultiline(
+        "##text",
+        value.data(),
+        value.size() + 1,
+        size,
+        ImGuiInputTextFlags_CallbackResize,
+        string_resize_callback,
+        static_cast<void*>(&value)
+    );
+    if (changed) {
+        line_index_for(ImGui::GetID("##lines")).invalidate();
+    }
+    return changed;
+}
+
 // Returns the size of a button for the given text
-ImVec2 button_size(const char* text)
+inline ImVec2 button_size(const char* text)
 {
     const auto text_size = ImGui::CalcTextSize(text);
     const auto padding = ImGui::GetStyle().FramePadding;
@@ -647,6 +3523,212 @@ consteval const char* period_name()
     else return "[?]";  // TODO: When we have constexpr std::format, print the ratio
 }
 
+// Finds the value of the type identified by the tag at the given path within
+// a value, following the same indices as the Renderers: elements of ranges,
+// data members of aggregates and elements of tuples. Wrappers such as
+// std::optional and pointers do not add to the path, so they are looked
+// through until a value of the requested type is found. Const values cannot
+// be edited and so are never found.
+template <typename T>
+constexpr located locate(T& value, std::span<const std::uint32_t> path, const void* tag)
+{
+    using Type = std::remove_cv_t<T>;
+    if constexpr (!std::is_const_v<T>) {
+        if (path.empty() && tag == &type_tag<Type>) {
+            return {std::addressof(value), tag};
+        }
+    }
+
+    if constexpr (specialization_of<Type, ^^std::optional> ||
+                  specialization_of<Type, ^^std::unique_ptr> ||
+                  specialization_of<Type, ^^std::shared_ptr> ||
+                  specialization_of<Type, ^^std::indirect> ||
+                  (std::is_pointer_v<Type> && std::is_object_v<std::remove_pointer_t<Type>>)) {
+        return value ? locate(*value, path, tag) : located{};
+    }
+    else if constexpr (specialization_of<Type, ^^std::weak_ptr>) {
+        const auto shared = value.lock();
+        return shared ? locate(*shared, path, tag) : located{};
+    }
+    else if constexpr (specialization_of<Type, ^^std::variant>) {
+        return std::visit([&](auto& alternative) { return locate(alternative, path, tag); }, value);
+    }
+    else if constexpr (specialization_of<Type, ^^std::expected>) {
+        return value ? locate(*value, path, tag) : locate(value.error(), path, tag);
+    }
+    else if constexpr (std::ranges::forward_range<T>) {
+        if constexpr (std::is_lvalue_reference_v<std::ranges::range_reference_t<T>>) {
+            if (path.empty()) {
+                return {};
+            }
+            auto it = std::ranges::begin(value);
+            const auto end = std::ranges::end(value);
+            for (std::uint32_t i = 0; i != path[0] && it != end; ++i) {
+                ++it;
+            }
+            if (it != end) {
+                return locate(*it, path.subspan(1), tag);
+            }
+        }
+        return {};
+    }
+    else if constexpr (aggregate<Type>) {
+        located found;
+        if (path.empty()) {
+            return found;
+        }
+        template for (constexpr auto member : nsdm_of(^^Type)) {
+            if constexpr (!is_reference_type(type_of(member)) && !is_bit_field(member)) {
+                if (path[0] == MemberIndex(member)) {
+                    found = locate(value.[:member:], path.subspan(1), tag);
+                }
+            }
+        }
+        return found;
+    }
+    else if constexpr (tuple_like<Type>) {
+        located found;
+        if (path.empty()) {
+            return found;
+        }
+        template for (constexpr auto index : integer_sequence(tuple_size(^^Type))) {
+            if (path[0] == index) {
+                found = locate(std::get<index>(value), path.subspan(1), tag);
+            }
+        }
+        return found;
+    }
+    else {
+        return {};
+    }
+}
+
+template <typename T>
+located locate_root(void* root, std::span<const std::uint32_t> path, const void* tag)
+{
+    return locate(*static_cast<T*>(root), path, tag);
+}
+
+// Edits to the payload of a wrapper are recorded at the path of the wrapper,
+// and must be found through it.
+static_assert([] {
+    auto value = std::optional<std::string>{"text"};
+    return locate(value, {}, &type_tag<std::string>).ptr == std::addressof(*value) &&
+           locate(value, {}, &type_tag<std::optional<std::string>>).ptr == std::addressof(value);
+}());
+static_assert([] {
+    auto value = std::variant<int, std::string>{"text"};
+    return locate(value, {}, &type_tag<std::string>).ptr == std::addressof(std::get<1>(value)) &&
+           locate(value, {}, &type_tag<int>).ptr == nullptr;
+}());
+
+// Returns true if the class declares its own copy assignment operator, which
+// must be called rather than copying its members.
+consteval bool has_user_copy_assignment(std::meta::info type)
+{
+    const auto ctx = std::meta::access_context::unchecked();
+    for (const auto member : members_of(type, ctx)) {
+        if (is_copy_assignment(member) && is_user_provided(member)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns true if a copy of a value of the type shares some of its state with
+// the original, through pointers, references, smart pointers or views. Only
+// arrays, aggregates and the arguments of class templates are looked into; the
+// private members of other classes are assumed to be copied deeply.
+consteval bool has_shared_indirection(std::meta::info type, std::vector<std::meta::info>& seen)
+{
+    type = remove_cv(type);
+    if (is_reference_type(type)) {
+        return true;
+    }
+    if (is_pointer_type(type)) {
+        return !is_function_type(remove_pointer(type));
+    }
+    if (is_array_type(type)) {
+        return has_shared_indirection(remove_all_extents(type), seen);
+    }
+    if (!is_class_type(type) || std::ranges::contains(seen, type)) {
+        return false;
+    }
+    seen.push_back(type);
+
+    if (has_template_arguments(type)) {
+        const auto tmpl = template_of(type);
+        if (tmpl == ^^std::shared_ptr || tmpl == ^^std::weak_ptr || tmpl == ^^std::span ||
+            tmpl == ^^std::basic_string_view || tmpl == ^^std::reference_wrapper) {
+            return true;
+        }
+        for (const auto arg : template_arguments_of(type)) {
+            if (is_type(arg) && has_shared_indirection(arg, seen)) {
+                return true;
+            }
+        }
+    }
+
+    if (is_aggregate_type(type)) {
+        const auto ctx = std::meta::access_context::current();
+        for (const auto base : bases_of(type, ctx)) {
+            if (has_shared_indirection(type_of(base), seen)) {
+                return true;
+            }
+        }
+        for (const auto member : nonstatic_data_members_of(type, ctx)) {
+            if (has_shared_indirection(type_of(member), seen)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+consteval bool has_shared_indirection(std::meta::info type)
+{
+    std::vector<std::meta::info> seen;
+    return has_shared_indirection(type, seen);
+}
+
+static_assert(!has_shared_indirection(^^std::map<int, std::vector<std::string>>));
+static_assert(has_shared_indirection(^^std::vector<std::optional<int*>>));
+static_assert(has_shared_indirection(^^std::string_view));
+
+// Copies a value over another of the same type, reusing the storage of the
+// destination. Trivially copyable values are copied with memcpy and aggregates
+// member by member, including their base classes, so their trivially copyable
+// parts are too. Everything else is assigned, which lets containers such as
+// std::vector keep their capacity.
+template <typename T>
+void copy_value(T& dst, const T& src)
+{
+    if constexpr (std::is_trivially_copyable_v<T> && std::is_trivially_copy_assignable_v<T>) {
+        std::memcpy(std::addressof(dst), std::addressof(src), sizeof(T));
+    }
+    else if constexpr (std::is_array_v<T>) {
+        for (std::size_t i = 0; i != std::extent_v<T>; ++i) {
+            copy_value(dst[i], src[i]);
+        }
+    }
+    else if constexpr (aggregate<T> && !has_user_copy_assignment(^^T)) {
+        template for (constexpr auto base : bases_of_type(^^T)) {
+            using Base = [:type_of(base):];
+            copy_value(static_cast<Base&>(dst), static_cast<const Base&>(src));
+        }
+        template for (constexpr auto member : nsdm_of(^^T)) {
+            if constexpr (is_bit_field(member)) {
+                dst.[:member:] = src.[:member:];
+            } else {
+                copy_value(dst.[:member:], src.[:member:]);
+            }
+        }
+    }
+    else {
+        dst = src;
+    }
+}
+
 } // namespace detail
 
 // ============================================================================
@@ -660,54 +3742,41 @@ struct Renderer<config, T>
     {
         bool changed = false;
         if (TreeNodeExNoDisable(name)) {
-            std::stack<bool> region_states;
+            detail::region_stack<detail::max_region_depth(^^T)> regions;
             template for (constexpr auto member : detail::nsdm_of(^^T)) {
-                constexpr auto attns = detail::get_all_attns(^^T, member);
-                constexpr auto new_config = Config{attns.data(), attns.size()};
-
-                if constexpr (new_config.HasAttn<EndRegion>()) {
-                    std::size_t current_levels = 0;
-                    while (!region_states.empty()) {
-                        if (region_states.top()) {
-                            ImGui::TreePop();
-                        }
-                        region_states.pop();
-                        ++current_levels;
+                constexpr auto new_config = detail::member_config(^^T, member);
 
-                        if (current_levels == new_config.FetchAttn<EndRegion>()->levels) {
-                            break;
-                        }
-                    }
+                if constexpr (constexpr auto er = new_config.FetchAttn<EndRegion>()) {
+                    regions.end(er->levels);
                 }
                 if constexpr (constexpr auto br = new_config.FetchAttn<BeginRegion>()) {
-                    if (region_states.empty() || region_states.top()) {
-                        region_states.push(TreeNodeExNoDisable(br->title));
-                    } else {
-                        region_states.push(false);
-                    }
+                    regions.begin(br->title);
                 }
 
                 if constexpr (!new_config.HasAttn<Ignore>()) {
-                    if (region_states.empty() || region_states.top()) {
+                    if (regions.visible()) {
                         if constexpr (constexpr auto separator = new_config.FetchAttn<Separator>()) {
                             ImGui::SeparatorText(separator->title);
                         }
 
+                        constexpr auto& id = detail::member_id<member>;
+                        constexpr float highlight = detail::member_highlight(new_config, ^^T);
                         if constexpr (new_config.HasAttn<Readonly>()) {
-                            Input<new_config>(identifier_of(member).data(), std::as_const(x.[:member:]));
+                            detail::render_member<new_config, highlight>(MemberIndex(member), id, identifier_of(member).data(), std::as_const(x.[:member:]));
                         } else {
-                            changed = Input<new_config>(identifier_of(member).data(), x.[:member:]) || changed;
+                            const bool member_changed = detail::render_member<new_config, highlight>(MemberIndex(member), id, identifier_of(member).data(), x.[:member:]);
+                            if constexpr (constexpr auto on_change = new_config.FetchAttnOfTemplate(^^OnChange)) {
+                                if (member_changed) {
+                                    std::invoke([:*on_change:].fn, x, x.[:member:]);
+                                }
+                            }
+                            changed = member_changed || changed;
                         }
                     }
                 }
             }
 
-            while (!region_states.empty()) {
-                if (region_states.top()) {
-                    ImGui::TreePop();
-                }
-                region_states.pop();
-            }
+            regions.end_all();
 
             ImGui::TreePop();
         }
@@ -718,54 +3787,58 @@ struct Renderer<config, T>
     static bool Render(const char* name, const T& x)
     {
         if (TreeNodeExNoDisable(name)) {
-            std::stack<bool> region_states;
+            detail::region_stack<detail::max_region_depth(^^T)> regions;
             template for (constexpr auto member : detail::nsdm_of(^^T)) {
-                constexpr auto attns = detail::get_all_attns(^^T, member);
-                constexpr auto new_config = Config{attns.data(), attns.size()};
-
-                if constexpr (new_config.HasAttn<EndRegion>()) {
-                    std::size_t current_levels = 0;
-                    while (!region_states.empty()) {
-                        if (region_states.top()) {
-                            ImGui::TreePop();
-                        }
-                        region_states.pop();
-                        ++current_levels;
+                constexpr auto new_config = detail::member_config(^^T, member);
 
-                        if (current_levels == new_config.FetchAttn<EndRegion>()->levels) {
-                            break;
-                        }
-                    }
+                if constexpr (constexpr auto er = new_config.FetchAttn<EndRegion>()) {
+                    regions.end(er->levels);
                 }
                 if constexpr (constexpr auto br = new_config.FetchAttn<BeginRegion>()) {
-                    if (region_states.empty() || region_states.top()) {
-                        region_states.push(TreeNodeExNoDisable(br->title));
-                    } else {
-                        region_states.push(false);
-                    }
+                    regions.begin(br->title);
                 }
 
                 if constexpr (!new_config.HasAttn<Ignore>()) {
-                    if (region_states.empty() || region_states.top()) {
+                    if (regions.visible()) {
                         if constexpr (constexpr auto separator = new_config.FetchAttn<Separator>()) {
                             ImGui::SeparatorText(separator->title);
                         }
-    
-                        Input<new_config>(identifier_of(member).data(), x.[:member:]);
+
+                        constexpr auto& id = detail::member_id<member>;
+                        constexpr float highlight = detail::member_highlight(new_config, ^^T);
+                        detail::render_member<new_config, highlight>(MemberIndex(member), id, identifier_of(member).data(), x.[:member:]);
                     }
                 }
             }
 
-            while (!region_states.empty()) {
-                if (region_states.top()) {
-                    ImGui::TreePop();
-                }
-                region_states.pop();
-            }
+            regions.end_all();
+
+            ImGui::TreePop();
+        }
 
+        return false;
+    }
+};
+
+template <Config config, detail::table_driven_aggregate T>
+struct Renderer<config, T>
+{
+    static bool Render(const char* name, T& x)
+    {
+        bool changed = false;
+        if (TreeNodeExNoDisable(name)) {
+            changed = detail::render_descriptors(detail::field_descriptors<T>, std::addressof(x), true);
             ImGui::TreePop();
         }
+        return changed;
+    }
 
+    static bool Render(const char* name, const T& x)
+    {
+        if (TreeNodeExNoDisable(name)) {
+            detail::render_descriptors(detail::field_descriptors<T>, std::addressof(x), false);
+            ImGui::TreePop();
+        }
         return false;
     }
 };
@@ -775,22 +3848,25 @@ struct Renderer<config, T>
 {
     static bool Render(const char* name, T& value)
     {
+        constexpr auto entries = detail::enum_entries<T>();
         bool changed = false;
         if constexpr (config.HasAttn<Radio>()) {
             ImGui::Text("%s", name);
-            template for (constexpr auto e : detail::enums_of(^^T)) {
+            for (const auto& entry : entries) {
+                const auto option = static_cast<T>(entry.value);
                 ImGui::SameLine();
-                if (ImGui::RadioButton(identifier_of(e).data(), value == [:e:])) {
-                    value = [:e:];
+                if (ImGui::RadioButton(entry.name, value == option)) {
+                    value = option;
                     changed = true;
                 }
             }
         } else {
             const auto value_name = detail::enum_to_string(value);
             if (ImGui::BeginCombo(name, value_name)) {
-                template for (constexpr auto e : detail::enums_of(^^T)) {
-                    if (ImGui::Selectable(identifier_of(e).data(), value == [:e:])) {
-                        value = [:e:];
+                for (const auto& entry : entries) {
+                    const auto option = static_cast<T>(entry.value);
+                    if (ImGui::Selectable(entry.name, value == option)) {
+                        value = option;
                         changed = true;
                     }
                 }
@@ -983,26 +4059,24 @@ struct Renderer<config, std::string>
 {
     static bool Render(const char* name, std::string& value)
     {
-        auto callback = [](ImGuiInputTextCallbackData* data) -> int {
-            if (data->EventFlag == ImGuiInputTextFlags_CallbackResize) {
-                auto* str = static_cast<std::string*>(data->UserData);
-                str->resize(data->BufTextLen);
-                data->Buf = str->data();
-            }
-            return 0;
-        };
+        if constexpr (constexpr auto multiline = config.FetchAttn<Multiline>()) {
+            return detail::render_multiline_string(name, value, multiline->lines);
+        }
         return ImGui::InputText(
             name,
             value.data(),
             value.size() + 1,
             ImGuiInputTextFlags_CallbackResize,
-            callback,
+            detail::string_resize_callback,
             static_cast<void*>(&value)
         );
     }
 
     static bool Render(const char* name, const std::string& value)
     {
+        if constexpr (config.HasAttn<Multiline>()) {
+            return Renderer<config, std::string_view>::Render(name, value);
+        }
         return Renderer<config, const char*>::Render(name, value.c_str());
     }
 };
@@ -1012,6 +4086,11 @@ struct Renderer<config, std::string_view>
 {
     static bool Render(const char* name, std::string_view value)
     {
+        if constexpr (constexpr auto multiline = config.FetchAttn<Multiline>()) {
+            ImGui::Text("%s", name);
+            detail::render_text_viewer(value, multiline->lines);
+            return false;
+        }
         ImGui::Text("%s: %.*s", name, static_cast<int>(value.size()), value.data());
         return false;
     }
@@ -1065,11 +4144,13 @@ struct Renderer<config, std::optional<T>>
             changed = Input<config>(name, *value) || should_remove;
 
             if (should_remove) {
+                detail::record_value_change(value, std::optional<T>{});
                 value = {}; // Delay this so as not to pass invalid memory to Render
             }
         } else {
             if constexpr (std::default_initializable<T>) {
                 if (ImGui::Button("Add", detail::button_size("Remove"))) {
+                    detail::record_value_change(std::optional<T>{}, std::optional<T>{std::in_place});
                     value.emplace();
                     changed = true;
                 }
@@ -1109,6 +4190,7 @@ struct Renderer<config, std::variant<Ts...>>
                 template for (constexpr auto index : detail::integer_sequence(sizeof...(Ts))) {
                     ImGui::PushID(index);
                     if (ImGui::Selectable(type_names[index])) {
+                        detail::record_variant_emplace<index>(value);
                         value.template emplace<index>();
                         changed = true;
                     }
@@ -1169,10 +4251,12 @@ struct Renderer<config, std::expected<T, E>>
             ImGui::SetNextItemWidth(ImGui::CalcItemWidth() / 3 - style.ItemInnerSpacing.x);
             if (ImGui::BeginCombo("##combo_box", value.has_value() ? "value" : "error")) {
                 if (ImGui::Selectable("value")) {
+                    detail::record_expected_switch<true>(value);
                     value = T{};
                     changed = true;
                 }
                 if (ImGui::Selectable("error")) {
+                    detail::record_expected_switch<false>(value);
                     value = std::unexpected(E{});
                     changed = true;
                 }
@@ -1286,7 +4370,7 @@ struct Renderer<config, std::bitset<N>>
         template for (constexpr auto i : detail::integer_sequence(N)) {
             bool proxy = value[i];
             if constexpr (config.HasAttn<InLine>()) { ImGui::SameLine(); }
-            changed = Input<config>(detail::fmt("[{}]", i), proxy) || changed;
+            changed = Input<config>(detail::index_label("[", i, "]"), proxy) || changed;
             value[i] = proxy;
         }
         return changed;
@@ -1297,7 +4381,7 @@ struct Renderer<config, std::bitset<N>>
         ImGui::Text("%s", name);
         template for (constexpr auto i : detail::integer_sequence(N)) {
             if constexpr (config.HasAttn<InLine>()) { ImGui::SameLine(); }
-            Input<config>(detail::fmt("[{}]", i), value[i]);
+            Input<config>(detail::index_label("[", i, "]"), value[i]);
         }
         return false;
     }
@@ -1533,6 +4617,101 @@ struct Renderer<config, std::chrono::duration<Rep, Period>>
     }
 };
 
+// ============================================================================
+// LIBRARY PROFILER
+// ============================================================================
+
+// Sets the time that ImRefl may spend rendering in a single frame before the
+// profiler keeps a breakdown of that frame for later inspection. A value of
+// zero disables the capture. Only has an effect with IMREFL_ENABLE_PROFILER.
+inline void SetProfilerBudget(float milliseconds)
+{
+#ifdef IMREFL_ENABLE_PROFILER
+    detail::profiler().budget_ms = milliseconds;
+#endif
+}
+
+// Shows a window listing the cost of rendering each Renderer type and field
+// path in the last frame, or in the last frame that exceeded the budget.
+// Profiling is compiled out unless IMREFL_ENABLE_PROFILER is defined before
+// including this header.
+inline void ShowProfilerWindow(bool* open = nullptr)
+{
+    if (!ImGui::Begin("ImRefl Profiler", open)) {
+        ImGui::End();
+        return;
+    }
+
+#ifdef IMREFL_ENABLE_PROFILER
+    auto& state = detail::profiler();
+
+    static bool show_hitch = false;
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+    ImGui::DragFloat("Frame budget", &state.budget_ms, 0.01f, 0.0f, 1000.0f, "%.2f ms");
+    ImGui::SameLine();
+    ImGui::Checkbox("Show last frame over budget", &show_hitch);
+
+    const detail::profile_frame& frame = show_hitch ? state.hitch : state.last;
+    if (frame.frame == -1) {
+        ImGui::TextUnformatted("No frame captured yet.");
+        ImGui::End();
+        return;
+    }
+    ImGui::Text("Frame %d: %.3f ms", frame.frame, frame.total_ns / 1e6);
+
+    const auto show_table = [](const char* id, const char* heading, const auto& entries, const auto& label_of) {
+        std::vector<std::pair<const char*, const detail::profile_entry*>> rows;
+        rows.reserve(entries.size());
+        for (const auto& [key, entry] : entries) {
+            rows.emplace_back(label_of(key), &entry);
+        }
+        std::ranges::sort(rows, std::greater{}, [](const auto& row) { return row.second->inclusive_ns; });
+
+        const int flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+        if (ImGui::BeginTable(id, 5, flags, {0.0f, ImGui::GetTextLineHeightWithSpacing() * 16})) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn(heading, ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableSetupColumn("Inclusive (ms)");
+            ImGui::TableSetupColumn("Exclusive (ms)");
+            ImGui::TableSetupColumn("Vertices");
+            ImGui::TableHeadersRow();
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(rows.size()));
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                    const auto& [label, entry] = rows[i];
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::TextUnformatted(label);
+                    ImGui::TableNextColumn(); ImGui::Text("%zu", entry->calls);
+                    ImGui::TableNextColumn(); ImGui::Text("%.3f", entry->inclusive_ns / 1e6);
+                    ImGui::TableNextColumn(); ImGui::Text("%.3f", entry->exclusive_ns / 1e6);
+                    ImGui::TableNextColumn(); ImGui::Text("%zu", entry->vertices);
+                }
+            }
+            ImGui::EndTable();
+        }
+    };
+
+    if (ImGui::BeginTabBar("##views")) {
+        if (ImGui::BeginTabItem("By type")) {
+            show_table("##types", "Type", frame.by_type, [](const char* type) { return type; });
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("By field")) {
+            show_table("##paths", "Field", frame.by_path, [&](ImGuiID id) { return state.path_names[id].c_str(); });
+            ImGui::EndTabItem();
+        }
+        ImGui::EndTabBar();
+    }
+#else
+    ImGui::TextWrapped("Profiling is disabled. Define IMREFL_ENABLE_PROFILER before including imrefl.hpp to enable it.");
+#endif
+
+    ImGui::End();
+}
+
 }  // namespace ImRefl
 
 #endif // INCLUDED_IMREFL_H
@@ -0,0 +1,52 @@
+// The contents of imrefl.hpp as a partition of the imrefl module. The headers
+// it depends on are included in the global module fragment, so its own
+// includes are skipped by their include guards.
+module;
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cfloat>
+#include <climits>
+#include <charconv>
+#include <chrono>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <concepts>
+#include <expected>
+#include <format>
+#include <functional>
+#include <map>
+#include <memory>
+#include <meta>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <set>
+#include <source_location>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+export module imrefl:core;
+
+#define IMREFL_MODULE
+#define IMREFL_EXPORT export
+
+// Attached to the global module so that the entities are the same as those
+// declared by imrefl.hpp in translation units that include the header.
+extern "C++" {
+#include "imrefl.hpp"
+}
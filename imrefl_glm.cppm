@@ -0,0 +1,16 @@
+// The contents of imrefl_glm.hpp as a partition of the imrefl module.
+module;
+
+#include <glm/glm.hpp>
+#include <span>
+
+export module imrefl:glm;
+
+import :core;
+
+#define IMREFL_MODULE
+#define IMREFL_EXPORT export
+
+extern "C++" {
+#include "imrefl_glm.hpp"
+}
@@ -1,12 +1,14 @@
 #ifndef INCLUDED_IMREFL_GLM_H
 #define INCLUDED_IMREFL_GLM_H
 
+#ifndef IMREFL_MODULE
 #include "imrefl.hpp"
+#endif
 
 #include <glm/glm.hpp>
 #include <span>
 
-namespace ImRefl {
+IMREFL_EXPORT namespace ImRefl {
 
 template <Config config, int Size, detail::scalar T, glm::qualifier Qual>
 struct Renderer<config, glm::vec<Size, T, Qual>>